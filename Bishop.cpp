@@ -1,10 +1,9 @@
 // Bryan Liu (chl312), Dept. of Computing, Imperial College London
 // Bishop.cpp - implementation of Bishop extending Piece (info in Bishop.hpp)
 
-#include "pch.h"
 #include "Bishop.hpp"
 
-Bishop::Bishop(bool isWhitePlayer) : Piece(isWhitePlayer) {
+Bishop::Bishop(bool isWhitePlayer) : Piece(isWhitePlayer, BISHOP) {
 
 }
 
@@ -12,11 +11,6 @@ Bishop::~Bishop() {
 
 }
 
-Bishop* Bishop::clone()
-{
-	return new Bishop(this->isWhitePlayer());
-}
-
 /* A Bishop's move is valid if:
    - The destination is on the same diagonal as its current position
    - There is no obstruction (any piece) in intermediate squares
@@ -26,26 +20,27 @@ Bishop* Bishop::clone()
    Bishop.isValidMove() post-cond: retrun 0 if move is valid as above
 								   respective error code otherwise
 */
-int Bishop::isValidMove(wstring sourceFileRank, wstring destFileRank, map<wstring, Piece*>* board)
+int Bishop::isValidMove(int sourceSquare, int destSquare, const Position* board)
 {
 
-	if (isSameFile(sourceFileRank, destFileRank) &&
-		isSameRank(sourceFileRank, destFileRank))
+	if (isSameFile(sourceSquare, destSquare) &&
+		isSameRank(sourceSquare, destSquare))
 	{
 		return ChessErrHandler::DEST_EQ_SOURCE;
 	}
 
-	if (!isSameDiagonal(sourceFileRank, destFileRank))
+	if (!isSameDiagonal(sourceSquare, destSquare))
 	{
 		return ChessErrHandler::ILLEGAL_MOVE_PATTERN;
 	}
 
-	if (!noDiagonalObstruction(sourceFileRank, destFileRank, board))
+	// The Bishop attacks up to (and including) the first piece on its diagonals
+	if (!testSquare(bishopAttacks(sourceSquare, board->occupied()), destSquare))
 	{
 		return ChessErrHandler::OBSTRUCTION_EN_ROUTE;
 	}
 
-	if (destExistFriendlyPiece(destFileRank, board))
+	if (destExistFriendlyPiece(destSquare, board))
 	{
 		return ChessErrHandler::FRIENDLY_AT_DEST;
 	}
@@ -73,5 +68,10 @@ wstring Bishop::toGraphics()
 
 int Bishop::Score()
 {
-	return 10;
+	return 330;
+}
+
+int Bishop::EndgameScore()
+{
+	return 320;
 }
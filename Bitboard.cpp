@@ -0,0 +1,316 @@
+/* Copyright (C) 2024-2026 Stefan-Mihai MOGA
+This file is part of ChessCtrl application developed by Stefan-Mihai MOGA.
+Fully featured Chess Control written in C++ with the help of the MFC library.
+
+ChessCtrl is free software: you can redistribute it and/or modify it
+under the terms of the GNU General Public License as published by the Open
+Source Initiative, either version 3 of the License, or any later version.
+
+ChessCtrl is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+ChessCtrl. If not, see <http://www.opensource.org/licenses/gpl-3.0.html>*/
+
+// Bitboard.cpp - Implementation of Bitboard (info in Bitboard.hpp)
+
+#include "Bitboard.hpp"
+#include "Position.hpp"
+
+#if defined(_MSC_VER) && defined(_M_X64)
+#include <intrin.h>
+#elif defined(__GNUC__) && defined(__x86_64__)
+#include <cpuid.h>
+#include <immintrin.h>
+#endif
+
+Bitboard knightAttackTable[64];
+Bitboard kingAttackTable[64];
+Bitboard pawnAttackTable[2][64];
+Bitboard betweenTable[64][64];
+
+Magic rookMagics[64];
+Magic bishopMagics[64];
+bool usePext = false;
+
+// Every subset of every square's mask: 4096 entries at most for a Rook
+static const int ROOK_TABLE_SIZE = 0x19000;
+static const int BISHOP_TABLE_SIZE = 0x1480;
+static const int MAX_MASK_SUBSETS = 4096;
+
+static Bitboard rookTable[ROOK_TABLE_SIZE];
+static Bitboard bishopTable[BISHOP_TABLE_SIZE];
+
+static const Bitboard RANK_1_BB = 0xFFULL;
+static const Bitboard RANK_8_BB = RANK_1_BB << 56;
+static const Bitboard FILE_A_BB = 0x0101010101010101ULL;
+static const Bitboard FILE_H_BB = FILE_A_BB << 7;
+
+/* Rays are indexed by direction: the first four directions increase the
+	 square number (the nearest blocker is the lowest bit of the ray), the
+	 last four decrease it (the nearest blocker is the highest bit)
+*/
+enum Direction { NORTH, EAST, NORTH_EAST, NORTH_WEST, SOUTH, WEST, SOUTH_WEST, SOUTH_EAST, NUM_DIRECTIONS };
+
+static const int directionFile[NUM_DIRECTIONS] = { 0, 1, 1, -1, 0, -1, -1, 1 };
+static const int directionRank[NUM_DIRECTIONS] = { 1, 0, 1, 1, -1, 0, -1, -1 };
+
+static Bitboard rayTable[NUM_DIRECTIONS][64];
+
+static bool onBoard(int file, int rank)
+{
+	return file >= 0 && file < ChessInfo::NUM_FILES && rank >= 0 && rank < ChessInfo::NUM_RANKS;
+}
+
+// Union of the squares reached from square by each (file, rank) offset
+static Bitboard offsetsToBitboard(int square, const int offsets[][2], int count)
+{
+	Bitboard bb = EMPTY_BB;
+	for (int index = 0; index < count; index++)
+	{
+		int file = fileOf(square) + offsets[index][0];
+		int rank = rankOf(square) + offsets[index][1];
+		if (onBoard(file, rank))
+		{
+			bb |= squareBB(makeSquare(file, rank));
+		}
+	}
+	return bb;
+}
+
+static void initAttackTables()
+{
+	static const int knightOffsets[8][2] = { { 1, 2 }, { 2, 1 }, { 2, -1 }, { 1, -2 },
+		{ -1, -2 }, { -2, -1 }, { -2, 1 }, { -1, 2 } };
+	static const int kingOffsets[8][2] = { { 0, 1 }, { 1, 1 }, { 1, 0 }, { 1, -1 },
+		{ 0, -1 }, { -1, -1 }, { -1, 0 }, { -1, 1 } };
+	static const int whitePawnOffsets[2][2] = { { -1, 1 }, { 1, 1 } };
+	static const int blackPawnOffsets[2][2] = { { -1, -1 }, { 1, -1 } };
+
+	for (int square = 0; square < ChessInfo::NUM_SQUARES; square++)
+	{
+		knightAttackTable[square] = offsetsToBitboard(square, knightOffsets, 8);
+		kingAttackTable[square] = offsetsToBitboard(square, kingOffsets, 8);
+		pawnAttackTable[0][square] = offsetsToBitboard(square, whitePawnOffsets, 2);
+		pawnAttackTable[1][square] = offsetsToBitboard(square, blackPawnOffsets, 2);
+
+		for (int direction = 0; direction < NUM_DIRECTIONS; direction++)
+		{
+			Bitboard ray = EMPTY_BB;
+			int file = fileOf(square) + directionFile[direction];
+			int rank = rankOf(square) + directionRank[direction];
+			while (onBoard(file, rank))
+			{
+				int destSquare = makeSquare(file, rank);
+				betweenTable[square][destSquare] = ray;
+				ray |= squareBB(destSquare);
+				file += directionFile[direction];
+				rank += directionRank[direction];
+			}
+			rayTable[direction][square] = ray;
+		}
+	}
+}
+
+/* Ray walk along one direction, stopping at the first piece met: only used
+	 to fill the magic tables below
+*/
+static Bitboard rayAttacks(int square, Bitboard occupied, int direction)
+{
+	Bitboard ray = rayTable[direction][square];
+	Bitboard blockers = ray & occupied;
+	if (blockers != EMPTY_BB)
+	{
+		int blocker = direction < SOUTH ? lsbSquare(blockers) : msbSquare(blockers);
+		ray ^= rayTable[direction][blocker];
+	}
+	return ray;
+}
+
+static Bitboard slowRookAttacks(int square, Bitboard occupied)
+{
+	return rayAttacks(square, occupied, NORTH) | rayAttacks(square, occupied, EAST) |
+		rayAttacks(square, occupied, SOUTH) | rayAttacks(square, occupied, WEST);
+}
+
+static Bitboard slowBishopAttacks(int square, Bitboard occupied)
+{
+	return rayAttacks(square, occupied, NORTH_EAST) | rayAttacks(square, occupied, NORTH_WEST) |
+		rayAttacks(square, occupied, SOUTH_WEST) | rayAttacks(square, occupied, SOUTH_EAST);
+}
+
+#if defined(_MSC_VER) && defined(_M_X64)
+unsigned pextIndex(Bitboard occupied, Bitboard mask)
+{
+	return (unsigned)_pext_u64(occupied, mask);
+}
+
+static void cpuid(unsigned leaf, unsigned registers[4])
+{
+	int info[4];
+	__cpuidex(info, (int)leaf, 0);
+	for (int index = 0; index < 4; index++)
+	{
+		registers[index] = (unsigned)info[index];
+	}
+}
+#elif defined(__GNUC__) && defined(__x86_64__)
+__attribute__((target("bmi2")))
+unsigned pextIndex(Bitboard occupied, Bitboard mask)
+{
+	return (unsigned)_pext_u64(occupied, mask);
+}
+
+static void cpuid(unsigned leaf, unsigned registers[4])
+{
+	registers[0] = registers[1] = registers[2] = registers[3] = 0;
+	__get_cpuid_count(leaf, 0, &registers[0], &registers[1], &registers[2], &registers[3]);
+}
+#else
+unsigned pextIndex(Bitboard occupied, Bitboard mask)
+{
+	UNREFERENCED_PARAMETER(occupied);
+	UNREFERENCED_PARAMETER(mask);
+	return 0;
+}
+#define BITBOARD_NO_CPUID
+#endif
+
+/* cpuHasFastPext():
+   True if the processor implements BMI2 in hardware: AMD processors before
+	 Zen 3 (family 19h) execute PEXT in microcode, slower than the magic
+	 multiplication, so they keep the portable path
+*/
+static bool cpuHasFastPext()
+{
+#ifdef BITBOARD_NO_CPUID
+	return false;
+#else
+	unsigned registers[4];
+	cpuid(0, registers);
+	unsigned maxLeaf = registers[0];
+	bool isAmd = registers[1] == 0x68747541; // "Auth" of "AuthenticAMD"
+	if (maxLeaf < 7)
+	{
+		return false;
+	}
+
+	cpuid(7, registers);
+	bool hasBmi2 = (registers[1] & (1u << 8)) != 0;
+	if (!hasBmi2 || !isAmd)
+	{
+		return hasBmi2;
+	}
+
+	cpuid(1, registers);
+	unsigned family = (registers[0] >> 8) & 0xF;
+	if (family == 0xF)
+	{
+		family += (registers[0] >> 20) & 0xFF;
+	}
+	return family >= 0x19;
+#endif
+}
+
+// xorshift64* generator, fixed seeds make the magic search reproducible
+static Bitboard nextRandom(Bitboard& state)
+{
+	state ^= state >> 12;
+	state ^= state << 25;
+	state ^= state >> 27;
+	return state * 2685821657736338717ULL;
+}
+
+// Magic candidates with few bits set are found much faster
+static Bitboard sparseRandom(Bitboard& state)
+{
+	return nextRandom(state) & nextRandom(state) & nextRandom(state);
+}
+
+/* initMagics():
+   Fill the attack table of one kind of sliding piece, square by square:
+	 enumerate every subset of the square's mask (carry-rippler trick) and
+	 store its attacks at the subset's index. Without PEXT, random magic
+	 numbers are tried until one maps all subsets without a harmful
+	 collision (two subsets may share an entry only if their attacks agree)
+*/
+static void initMagics(Magic magics[], Bitboard table[],
+	Bitboard (*slowAttacks)(int, Bitboard))
+{
+	// Seeds per rank, picked so that the search converges quickly
+	static const Bitboard seeds[ChessInfo::NUM_RANKS] =
+		{ 728, 10316, 55013, 32803, 12281, 15100, 16645, 255 };
+	static Bitboard occupancy[MAX_MASK_SUBSETS];
+	static Bitboard reference[MAX_MASK_SUBSETS];
+	static int epoch[MAX_MASK_SUBSETS];
+	int attempt = 0;
+	int size = 0;
+
+	for (int square = 0; square < ChessInfo::NUM_SQUARES; square++)
+	{
+		Magic& entry = magics[square];
+
+		// Pieces on the edges never block anything further
+		Bitboard edges = ((RANK_1_BB | RANK_8_BB) & ~(RANK_1_BB << (8 * rankOf(square)))) |
+			((FILE_A_BB | FILE_H_BB) & ~(FILE_A_BB << fileOf(square)));
+		entry.mask = slowAttacks(square, EMPTY_BB) & ~edges;
+		entry.shift = 64 - popCount(entry.mask);
+		entry.magic = 0;
+		entry.attacks = square == 0 ? table : magics[square - 1].attacks + size;
+
+		size = 0;
+		Bitboard subset = EMPTY_BB;
+		do
+		{
+			occupancy[size] = subset;
+			reference[size] = slowAttacks(square, subset);
+			if (usePext)
+			{
+				entry.attacks[pextIndex(subset, entry.mask)] = reference[size];
+			}
+			size++;
+			subset = (subset - entry.mask) & entry.mask;
+		} while (subset != EMPTY_BB);
+
+		if (usePext)
+		{
+			continue;
+		}
+
+		Bitboard state = seeds[rankOf(square)];
+		for (int index = 0; index < size; )
+		{
+			do
+			{
+				entry.magic = sparseRandom(state);
+			} while (popCount((entry.magic * entry.mask) >> 56) < 6);
+
+			// Entries from a previous attempt are stale once the epoch moves on
+			for (++attempt, index = 0; index < size; index++)
+			{
+				unsigned tableIndex = (unsigned)((occupancy[index] * entry.magic) >> entry.shift);
+				if (epoch[tableIndex] < attempt)
+				{
+					epoch[tableIndex] = attempt;
+					entry.attacks[tableIndex] = reference[index];
+				}
+				else if (entry.attacks[tableIndex] != reference[index])
+				{
+					break;
+				}
+			}
+		}
+	}
+}
+
+// The tables are ready before main() runs
+static struct AttackTablesInitializer {
+	AttackTablesInitializer()
+	{
+		initAttackTables();
+		usePext = cpuHasFastPext();
+		initMagics(rookMagics, rookTable, slowRookAttacks);
+		initMagics(bishopMagics, bishopTable, slowBishopAttacks);
+	}
+} attackTablesInitializer;
@@ -0,0 +1,166 @@
+/* Copyright (C) 2024-2026 Stefan-Mihai MOGA
+This file is part of ChessCtrl application developed by Stefan-Mihai MOGA.
+Fully featured Chess Control written in C++ with the help of the MFC library.
+
+ChessCtrl is free software: you can redistribute it and/or modify it
+under the terms of the GNU General Public License as published by the Open
+Source Initiative, either version 3 of the License, or any later version.
+
+ChessCtrl is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+ChessCtrl. If not, see <http://www.opensource.org/licenses/gpl-3.0.html>*/
+
+// Bitboard.hpp - Bitboard
+/* A Bitboard is a 64-bit set of squares, bit n standing for square n
+	 (A1 = bit 0, ..., H8 = bit 63, same numbering as Position)
+   The attack tables are computed once, when the program starts:
+	 knightAttacks() / kingAttacks() / pawnAttacks() are plain table lookups,
+	 rookAttacks() / bishopAttacks() / queenAttacks() take the occupancy of
+	 the board into account and stop at the first piece met in each direction
+	 (that piece being included, whichever its colour)
+   Sliding attacks are a single lookup in magic tables: the relevant
+	 occupancy of the square (its mask) is turned into a table index either
+	 with the BMI2 PEXT instruction, when the processor has a fast one, or
+	 with a multiplication by a magic number & shift (portable fallback)
+	 The choice is made once at start-up, see slidingAttacksUsePext()
+   betweenSquares() is the set of squares strictly between two squares on a
+	 common file, rank or diagonal, the empty set otherwise
+*/
+
+#ifndef BITBOARD_H
+#define BITBOARD_H
+
+#include <bit>
+
+#if defined(_MSC_VER) && defined(_M_X64)
+#include <immintrin.h>
+#define BITBOARD_PEXT_INTRINSIC
+#elif defined(__BMI2__) && defined(__x86_64__)
+#include <immintrin.h>
+#define BITBOARD_PEXT_INTRINSIC
+#endif
+
+typedef unsigned long long Bitboard;
+
+static const Bitboard EMPTY_BB = 0ULL;
+
+inline Bitboard squareBB(int square)
+{
+	return 1ULL << square;
+}
+
+inline bool testSquare(Bitboard bb, int square)
+{
+	return (bb & squareBB(square)) != 0;
+}
+
+inline int popCount(Bitboard bb)
+{
+	return std::popcount(bb);
+}
+
+// Lowest square of a non-empty bitboard
+inline int lsbSquare(Bitboard bb)
+{
+	return std::countr_zero(bb);
+}
+
+// Highest square of a non-empty bitboard
+inline int msbSquare(Bitboard bb)
+{
+	return 63 - std::countl_zero(bb);
+}
+
+// Remove and return the lowest square of a non-empty bitboard
+inline int popLsb(Bitboard& bb)
+{
+	int square = lsbSquare(bb);
+	bb &= bb - 1;
+	return square;
+}
+
+// Precomputed tables (filled in Bitboard.cpp), use the accessors below
+extern Bitboard knightAttackTable[64];
+extern Bitboard kingAttackTable[64];
+extern Bitboard pawnAttackTable[2][64];
+extern Bitboard betweenTable[64][64];
+
+inline Bitboard knightAttacks(int square)
+{
+	return knightAttackTable[square];
+}
+
+inline Bitboard kingAttacks(int square)
+{
+	return kingAttackTable[square];
+}
+
+// Squares attacked by a pawn of the given colour standing on square
+inline Bitboard pawnAttacks(int square, bool isWhitePlayer)
+{
+	return pawnAttackTable[isWhitePlayer ? 0 : 1][square];
+}
+
+inline Bitboard betweenSquares(int sourceSquare, int destSquare)
+{
+	return betweenTable[sourceSquare][destSquare];
+}
+
+/* Magic:
+   Per-square entry of the sliding attack tables, attacks points into the
+	 shared table of the piece kind, at the start of the square's slice
+*/
+struct Magic {
+	Bitboard mask;
+	Bitboard magic;
+	Bitboard* attacks;
+	unsigned shift;
+};
+
+extern Magic rookMagics[64];
+extern Magic bishopMagics[64];
+extern bool usePext;
+
+// True if the sliding attack tables are indexed with PEXT
+inline bool slidingAttacksUsePext()
+{
+	return usePext;
+}
+
+// Out of line where the compiler may not emit BMI2 instructions by default
+unsigned pextIndex(Bitboard occupied, Bitboard mask);
+
+inline unsigned magicIndex(const Magic& entry, Bitboard occupied)
+{
+	if (usePext)
+	{
+#ifdef BITBOARD_PEXT_INTRINSIC
+		return (unsigned)_pext_u64(occupied, entry.mask);
+#else
+		return pextIndex(occupied, entry.mask);
+#endif
+	}
+	return (unsigned)(((occupied & entry.mask) * entry.magic) >> entry.shift);
+}
+
+inline Bitboard rookAttacks(int square, Bitboard occupied)
+{
+	const Magic& entry = rookMagics[square];
+	return entry.attacks[magicIndex(entry, occupied)];
+}
+
+inline Bitboard bishopAttacks(int square, Bitboard occupied)
+{
+	const Magic& entry = bishopMagics[square];
+	return entry.attacks[magicIndex(entry, occupied)];
+}
+
+inline Bitboard queenAttacks(int square, Bitboard occupied)
+{
+	return rookAttacks(square, occupied) | bishopAttacks(square, occupied);
+}
+
+#endif
@@ -1,17 +1,18 @@
 // Bryan Liu (chl312), Dept. of Computing, Imperial College London
 // ChessBoard.cpp - Implementation of ChessBoard (Info in ChessBoard.hpp)
 
-#include "pch.h"
 #include "ChessBoard.hpp"
+#include <thread>
 
 using namespace std;
 
-ChessBoard::ChessBoard()
+ChessBoard::ChessBoard() : m_computerSearch(&m_transpositionTable, &m_bStopSearch)
 {
-	m_pParentWnd = nullptr;
-	m_pColorStatic = nullptr;
-	m_ctrlProgress = nullptr;
-	_board = new Board();
+	m_pObserver = nullptr;
+	m_bComputerThinking = false;
+	m_bStopSearch = false;
+	m_searchLimits.moveTime = 1000; // one second a move
+	m_searchThreads = (int)thread::hardware_concurrency(); // 0 if unknown, i.e. one thread
 	errorHandler = new ChessErrHandler();
 	piecePlaceholder = new EmptyPiece(true);
 	resetBoard();
@@ -19,7 +20,8 @@ ChessBoard::ChessBoard()
 
 ChessBoard::~ChessBoard()
 {
-	deepCleanBoard(_board);
+	StopComputerPlayer();
+	WaitComputerPlayer();
 	delete errorHandler;
 	delete piecePlaceholder;
 }
@@ -33,14 +35,15 @@ ChessBoard::~ChessBoard()
 	 - Is the source an non-empty square?
 	 - Is the piece on source square belongs to the player making the move?
 	 - Is the piece's move on the current board valid based on its type?
-   Try move: - In a sandbox to prevent messing up the original board
+	   (a Pawn reaching the last rank is promoted to a Queen, unless the
+		 move says otherwise)
+   Try move: - On the board itself, the move is taken back if it fails
 			 - Check: Does the move keeps current player's King in a safe
 					  position (i.e. NOT in check)?
-   Confirm the move on both the board and the piece
+   Confirm the move on the board, the turn having passed to the other player
    Print the move on screen, and check if the game can continue
-	 If yes, switch player and "wait" for next submitMove
+	 If yes, "wait" for next submitMove
 	 If no, print statement and final represenation of board
-   Finally do some nice memory management to prevent memory leakage
 */
 void ChessBoard::submitMove(const TCHAR* fromSquare, const TCHAR* toSquare)
 {
@@ -49,31 +52,53 @@ void ChessBoard::submitMove(const TCHAR* fromSquare, const TCHAR* toSquare)
 
 	if (!gameCanContinue(sourceFileRank, destFileRank)) return;
 	if (!sourceAndDestIsValid(sourceFileRank, destFileRank)) return;
-	if (!sourceIsNotEmpty(sourceFileRank, _board)) return;
 
-	Piece* piece = _board->at(sourceFileRank);
-	if (!isCurrentPlayerPiece(_isWhiteTurn, piece, sourceFileRank)) return;
+	submitMove(createMove(squareFromFileRank(sourceFileRank),
+		squareFromFileRank(destFileRank)));
+}
 
-	int returnCode = piece->isValidMove(sourceFileRank, destFileRank, _board);
-	if (!pieceMoveIsValid(returnCode, piece,
-		sourceFileRank, destFileRank)) return;
+/* ChessBoard.submitMove(Move):
+   Same checks as above, on a move given by its squares: flags other than
+	 PROMOTION_MOVE (with the piece promoted to) are not needed, they are
+	 recovered from the move generator
+*/
+void ChessBoard::submitMove(Move move)
+{
+	int sourceSquare = moveFrom(move);
+	int destSquare = moveTo(move);
 
-	Board* sandboxBoard = cloneBoard(_board);
-	Piece* capturedPiece = tryMoveAndReturnCaptured(sourceFileRank, destFileRank, sandboxBoard);
-	if (!pieceMoveKeepsKingSafe(_isWhiteTurn, piece, sourceFileRank, destFileRank, sandboxBoard)) return;
+	if (!gameCanContinue(fileRankOf(sourceSquare), fileRankOf(destSquare))) return;
+	if (!sourceIsNotEmpty(sourceSquare, &_board)) return;
 
-	confirmMoveOnBoard(sourceFileRank, destFileRank, _board);
+	Piece* piece = pieceAt(sourceSquare);
+	if (!isCurrentPlayerPiece(_board.isWhiteTurn, piece, sourceSquare)) return;
 
-	if (!showMoveAndCheckIfGameCanContinue(piece, sourceFileRank,
-		capturedPiece, destFileRank, _isWhiteTurn, _board))
+	int returnCode = piece->isValidMove(sourceSquare, destSquare, &_board);
+	if (!pieceMoveIsValid(returnCode, piece,
+		sourceSquare, destSquare)) return;
+
+	// The generated move carries what is special about it (castling, ...)
+	PieceType promotion = moveFlags(move) == PROMOTION_MOVE ?
+		(PieceType)movePromotion(move) : QUEEN;
+	move = findMove(&_board, sourceSquare, destSquare, promotion);
+	if (!pieceMoveIsValid(move != NO_MOVE ? ChessErrHandler::CHESS_NO_ERROR :
+		ChessErrHandler::ILLEGAL_MOVE_PATTERN, piece, sourceSquare, destSquare)) return;
+
+	UndoRecord undo;
+	Piece* capturedPiece = tryMoveAndReturnCaptured(move, &_board, undo);
+	if (!pieceMoveKeepsKingSafe(piece->isWhitePlayer(), piece, sourceSquare, destSquare, &_board))
 	{
-		endTheGame();
+		takeBackMove(move, &_board, undo);
+		return;
 	}
 
-	switchPlayers();
+	confirmMoveOnBoard();
 
-	delete capturedPiece;
-	deepCleanBoard(sandboxBoard);
+	if (!showMoveAndCheckIfGameCanContinue(piece, sourceSquare,
+		capturedPiece, destSquare, piece->isWhitePlayer(), &_board))
+	{
+		endTheGame();
+	}
 }
 
 /* ChessBoard.resetBoard (): i.e. make a new game
@@ -86,52 +111,61 @@ void ChessBoard::resetBoard()
 	makeWhiteGoesNext();
 	makeGameNotInCheck();
 
-	wstring fileRank(_T("A1"));
-	for (TCHAR i = ChessInfo::MIN_FILE; i <= ChessInfo::MAX_FILE; i++)
-	{
-		fileRank.front() = i;
+	static const PieceType backRank[ChessInfo::NUM_FILES] =
+		{ ROOK, KNIGHT, BISHOP, QUEEN, KING, BISHOP, KNIGHT, ROOK };
+	const int whitePawnRank = ChessInfo::WHITE_INIT_PAWN_RANK - ChessInfo::MIN_RANK;
+	const int blackPawnRank = ChessInfo::BLACK_INIT_PAWN_RANK - ChessInfo::MIN_RANK;
 
-		fileRank.back() = ChessInfo::WHITE_INIT_PAWN_RANK;
-		_board->insert({ fileRank, new Pawn(true) });
+	for (int file = 0; file < ChessInfo::NUM_FILES; file++)
+	{
+		_board.putPiece(makeSquare(file, whitePawnRank), makePieceCode(PAWN, true));
+		_board.putPiece(makeSquare(file, blackPawnRank), makePieceCode(PAWN, false));
 
-		fileRank.back() = ChessInfo::BLACK_INIT_PAWN_RANK;
-		_board->insert({ fileRank, new Pawn(false) });
+		_board.putPiece(makeSquare(file, 0), makePieceCode(backRank[file], true));
+		_board.putPiece(makeSquare(file, ChessInfo::NUM_RANKS - 1), makePieceCode(backRank[file], false));
 	}
-
-	_board->insert({ wstring(_T("A1")), new Rook(true) });
-	_board->insert({ wstring(_T("B1")), new Knight(true) });
-	_board->insert({ wstring(_T("C1")), new Bishop(true) });
-	_board->insert({ wstring(_T("D1")), new Queen(true) });
-	_board->insert({ wstring(_T("E1")), new King(true) });
-	_board->insert({ wstring(_T("F1")), new Bishop(true) });
-	_board->insert({ wstring(_T("G1")), new Knight(true) });
-	_board->insert({ wstring(_T("H1")), new Rook(true) });
-
-	_board->insert({ wstring(_T("A8")), new Rook(false) });
-	_board->insert({ wstring(_T("B8")), new Knight(false) });
-	_board->insert({ wstring(_T("C8")), new Bishop(false) });
-	_board->insert({ wstring(_T("D8")), new Queen(false) });
-	_board->insert({ wstring(_T("E8")), new King(false) });
-	_board->insert({ wstring(_T("F8")), new Bishop(false) });
-	_board->insert({ wstring(_T("G8")), new Knight(false) });
-	_board->insert({ wstring(_T("H8")), new Rook(false) });
+	_board.castlingRights = ALL_CASTLING;
+	_board.key = _board.computeKey();
+	m_transpositionTable.clear();
 
 	cout << "Let the game begin..." << endl;
-	if (m_pColorStatic != nullptr)
+	setStatus(_T("\x201C") _T("Every chess master was once a beginner.\x201D \x2013 Irving Chernev"));
+}
+
+bool ChessBoard::loadFEN(const char* fen)
+{
+	Position board;
+	if (!board.loadFEN(fen))
+	{
+		return false;
+	}
+
+	_board = board;
+	beginAGame();
+	if (kingIsSafeFromRivalry(_board.isWhiteTurn, &_board))
+	{
+		makeGameNotInCheck();
+	}
+	else
 	{
-		// m_pColorStatic->SetBackgroundColor(RGB(0xEE, 0xE8, 0xAA));
-		m_pColorStatic->SetWindowText(_T("Every chess master was once a beginner.  Irving Chernev"));
+		makeGameInCheck();
+	}
+	if (!playerHaveValidMove(_board.isWhiteTurn, &_board))
+	{
+		endTheGame();
 	}
+	m_transpositionTable.clear();
+
+	string text = toFEN();
+	setStatus(wstring(text.begin(), text.end()));
+	return true;
 }
 
 // The pre-defined setters (6 methods)
-/* getANewBoard () assumption:
-   board contains non-null pointer to a Board, thus can be deep cleaned
-*/
+// getANewBoard (): empty every square of the board
 void ChessBoard::getANewBoard()
 {
-	deepCleanBoard(this->_board);
-	_board = new Board;
+	_board.clear();
 }
 
 void ChessBoard::makeGameInCheck()
@@ -156,7 +190,7 @@ void ChessBoard::endTheGame()
 
 void ChessBoard::makeWhiteGoesNext()
 {
-	_isWhiteTurn = true;
+	_board.isWhiteTurn = true;
 }
 
 /* The following methods check certain conditions required for a valid chess
@@ -221,18 +255,12 @@ bool ChessBoard::withinChessBoard(wstring fileRank)
 /* sourceIsNotEmpty ():
    check if source is not an empty square (i.e. there is a piece to move)
 */
-bool ChessBoard::sourceIsNotEmpty(wstring sourceFileRank, Board* board)
+bool ChessBoard::sourceIsNotEmpty(int sourceSquare, Position* board)
 {
-	try
-	{
-		auto temp = board->at(sourceFileRank);
-		UNREFERENCED_PARAMETER(temp);
-	}
-	catch (const std::out_of_range& err)
+	if (board->isEmpty(sourceSquare))
 	{
-		UNREFERENCED_PARAMETER(err);
-		handleInvalidMove(ChessErrHandler::MOVED_EMPTY_PIECE,
-			piecePlaceholder, sourceFileRank, sourceFileRank);
+		handleInvalidMove(ChessErrHandler::MOVED_EMPTY_PIECE, piecePlaceholder,
+			fileRankOf(sourceSquare), fileRankOf(sourceSquare));
 		return false;
 	}
 	return true;
@@ -241,14 +269,14 @@ bool ChessBoard::sourceIsNotEmpty(wstring sourceFileRank, Board* board)
 /* isCurrentPlayerPiece ():
    check if the piece at source belongs to the player in turn
 */
-bool ChessBoard::isCurrentPlayerPiece(bool isWhiteTurn, Piece* piece, wstring sourceFileRank)
+bool ChessBoard::isCurrentPlayerPiece(bool isWhiteTurn, Piece* piece, int sourceSquare)
 {
 
 	bool isCurrentPlayerPiece = isWhiteTurn == piece->isWhitePlayer();
 	if (!isCurrentPlayerPiece)
 	{
 		handleInvalidMove(ChessErrHandler::NOT_OWNER_TURN, piece,
-			sourceFileRank, sourceFileRank);
+			fileRankOf(sourceSquare), fileRankOf(sourceSquare));
 	}
 	return isCurrentPlayerPiece;
 }
@@ -256,12 +284,13 @@ bool ChessBoard::isCurrentPlayerPiece(bool isWhiteTurn, Piece* piece, wstring so
 /* pieceMoveIsValid ():
    check if the return code for validating piece move is zero
 */
-bool ChessBoard::pieceMoveIsValid(int returnCode, Piece* piece, wstring sourceFileRank, wstring destFileRank)
+bool ChessBoard::pieceMoveIsValid(int returnCode, Piece* piece, int sourceSquare, int destSquare)
 {
 
 	if (returnCode != ChessErrHandler::CHESS_NO_ERROR)
 	{
-		handleInvalidMove(returnCode, piece, sourceFileRank, destFileRank);
+		handleInvalidMove(returnCode, piece,
+			fileRankOf(sourceSquare), fileRankOf(destSquare));
 		return false;
 	}
 	return true;
@@ -269,16 +298,16 @@ bool ChessBoard::pieceMoveIsValid(int returnCode, Piece* piece, wstring sourceFi
 
 /* pieceMoveKeepsKingSafe ():
    check if given side's King is safe under the given board
-   (in ChessBoard it would be a sandbox),
+   (in ChessBoard it would be the board with the move tried on it),
    if not give out an error to user and return false
 */
-bool ChessBoard::pieceMoveKeepsKingSafe(bool isWhiteTurn, Piece* piece, wstring sourceFileRank, wstring destFileRank, Board* board)
+bool ChessBoard::pieceMoveKeepsKingSafe(bool isWhiteTurn, Piece* piece, int sourceSquare, int destSquare, Position* board)
 {
 
 	if (!kingIsSafeFromRivalry(isWhiteTurn, board))
 	{
 		handleInvalidMove(ChessErrHandler::ALLOW_KING_IN_CHECK, piece,
-			sourceFileRank, destFileRank);
+			fileRankOf(sourceSquare), fileRankOf(destSquare));
 		return false;
 	}
 	return true;
@@ -295,145 +324,82 @@ void ChessBoard::handleInvalidMove
 }
 
 /* kingIsSafeFromRivalry ():
-   pre-cond.: board valid, existing representation of a Board
+   pre-cond.: board valid, existing Position
    Return true if none of the Pieces of the other side can capture the given
-	 side's King (i.e. has a valid move to the King's file and rank)
-   Method: Check all pieces of the other side
-		   For each piece check if its move to the given side's King is valid
-		   (if true, the given side's King is not safe)
+	 side's King (i.e. has a valid move to the King's square)
+   Method: Look up the attack tables from the King's square
+		   (see Position::isAttacked)
 */
-bool ChessBoard::kingIsSafeFromRivalry(bool isWhiteTurn, Board* board)
+bool ChessBoard::kingIsSafeFromRivalry(bool isWhiteTurn, Position* board)
 {
-	wstring kingFileRank = findPlayersKingFileRank(isWhiteTurn, board);
+	int kingSquare = findPlayersKingSquare(isWhiteTurn, board);
+	if (kingSquare == ChessInfo::NO_SQUARE) return true;
 
-	for (Board::const_iterator it = board->cbegin();
-		it != board->cend(); it++) {
-		wstring challengingFileRank = it->first;
-		Piece* challengingPiece = it->second;
-		if (challengingPiece->isWhitePlayer() != isWhiteTurn &&
-			challengingPiece->isValidMove(challengingFileRank,
-				kingFileRank, board) == ChessErrHandler::CHESS_NO_ERROR)
-		{
-			return false;
-		}
-	}
-	return true;
+	return !board->isAttacked(kingSquare, !isWhiteTurn);
 }
 
 /* playerHaveValidMove ():
-   pre-cond.: board valid, existing representation of a Board
+   pre-cond.: board valid, existing Position
    Return true if the given side have a valid move on the given board
-   Method: Check all pieces of the given side
-		   For each piece check all its valid move
-		   For each valid move check if given side's King is safe from attack
+   Method: Generate the moves of the given side (see MoveGen.hpp)
+		   For each move check if given side's King is safe from attack
 		   (if true, there is at least one valid move for the given side)
+   N.B.: The given side is made the side to move while generating, the
+		 board is left as it was found
 */
-bool ChessBoard::playerHaveValidMove(bool isWhiteTurn, Board* board)
+bool ChessBoard::playerHaveValidMove(bool isWhiteTurn, Position* board)
 {
-	for (Board::const_iterator it = board->cbegin(); it != board->cend(); ++it)
-	{
-		wstring possibleSource = it->first;
-		Piece* possiblePiece = it->second;
+	bool boardTurn = board->isWhiteTurn;
+	board->isWhiteTurn = isWhiteTurn;
 
-		if (possiblePiece->isWhitePlayer() == isWhiteTurn)
-		{
-			for (TCHAR i = ChessInfo::MIN_FILE; i <= ChessInfo::MAX_FILE; i++)
-			{
-				for (TCHAR j = ChessInfo::MIN_RANK; j <= ChessInfo::MAX_RANK; j++)
-				{
-
-					wstring possibleDest({ i, j });
-					if (possiblePiece->isValidMove(possibleSource,
-						possibleDest, board) == ChessErrHandler::CHESS_NO_ERROR)
-					{
-						Board* sandboxBoard = cloneBoard(board);
-						Piece* captured = tryMoveAndReturnCaptured(possibleSource, possibleDest, sandboxBoard);
-						bool haveValidMove = kingIsSafeFromRivalry(isWhiteTurn, sandboxBoard);
-
-						delete captured;
-						deepCleanBoard(sandboxBoard);
-
-						if (haveValidMove) return true;
-					}
-				}
-			}
-		}
+	bool haveValidMove = false;
+	Move moves[MAX_MOVES];
+	int count = generateMoves(board, moves);
+	for (int index = 0; index < count && !haveValidMove; index++)
+	{
+		haveValidMove = moveIsLegal(board, moves[index]);
 	}
-	return false;
+
+	board->isWhiteTurn = boardTurn;
+	return haveValidMove;
 }
 
-/* findPlayersKingFileRank ()
-   pre-cond.: board valid, existing representation of a Board
-   Iterate and return the location (file & rank) of the given side's King
+/* findPlayersKingSquare ()
+   pre-cond.: board valid, existing Position
+   Return the square of the given side's King
 */
-wstring ChessBoard::findPlayersKingFileRank(bool isWhiteTurn, Board* board)
+int ChessBoard::findPlayersKingSquare(bool isWhiteTurn, Position* board)
 {
-	for (Board::const_iterator it = board->cbegin(); it != board->cend(); it++)
-	{
-		wstring possibleFileRank = it->first;
-		Piece* possiblePiece = it->second;
-		if (possiblePiece->isWhitePlayer() == isWhiteTurn &&
-			possiblePiece->isKing() == true)
-		{
-			return possibleFileRank;
-		}
-	}
-	return _T("");
+	return board->findKing(isWhiteTurn);
 }
 
 /* tryMoveAndReturnCaptured ():
-   pre-cond.: sourceFileRank, destFileRank valid file & rank represenation
-			  board valid, existing rep. of a Board (expt. to be a sandbox)
-   Given a board, conduct move from source to destination & get the captured
-   Case 1 (try block) - Another piece in destination (conduct capture)
-   Case 2 (catch block) - No piece exists in destination (conduct move)
-   Return the piece if in case 1, NULL otherwise
+   pre-cond.: move generated for board
+			  board valid, existing Position
+   Given a board, conduct the move (passing the turn) & get the captured,
+	 what is needed to take the move back is saved in undo
+   Return the captured piece, nullptr if nothing was captured
 */
-Piece* ChessBoard::tryMoveAndReturnCaptured(wstring sourceFileRank, wstring destFileRank, Board* board)
+Piece* ChessBoard::tryMoveAndReturnCaptured(Move move, Position* board, UndoRecord& undo)
 {
+	return Piece::fromCode(board->makeMove(move, undo));
+}
 
-	Piece* sourcePiece = board->at(sourceFileRank);
-	Piece* destPiece;
-
-	try
-	{
-		destPiece = board->at(destFileRank);
-		board->at(destFileRank) = sourcePiece;
-	}
-	catch (const std::out_of_range& err)
-	{
-		UNREFERENCED_PARAMETER(err);
-		destPiece = NULL;
-		board->insert({ destFileRank, sourcePiece });
-	}
-	board->erase(sourceFileRank);
-
-	return destPiece;
+/* takeBackMove ():
+   pre-cond.: move is the last move tried on board, undo its record
+   Restore the board as it was before the move
+*/
+void ChessBoard::takeBackMove(Move move, Position* board, const UndoRecord& undo)
+{
+	board->unmakeMove(move, undo);
 }
 
 /* confirmMoveOnBoard ():
-   pre-cond.: sourceFileRank, destFileRank valid file & rank represenation
-			  board valid, existing rep. of a Board (expected to be a real one)
-   Given a board, conduct the move from source to destination
-   Case 1 (try block) - Another piece in destination (conduct capture)
-   Case 2 (catch block) - No piece exists in destination (conduct move)
+   The move tried on the board is kept: a new move starts out of check
+	 until showMoveAndCheckIfGameCanContinue() finds otherwise
 */
-void ChessBoard::confirmMoveOnBoard(wstring sourceFileRank, wstring destFileRank, Board* board)
+void ChessBoard::confirmMoveOnBoard()
 {
-	Piece* movingPiece = board->at(sourceFileRank);
-	try
-	{
-		Piece* destPiece = board->at(destFileRank);
-		delete destPiece;
-		board->at(destFileRank) = movingPiece;
-	}
-	catch (const std::out_of_range& err) {
-		UNREFERENCED_PARAMETER(err);
-		board->insert({ destFileRank, movingPiece });
-	}
-
-	movingPiece->confirmMove();
-	board->erase(sourceFileRank);
 	makeGameNotInCheck();
 }
 
@@ -452,10 +418,10 @@ void ChessBoard::confirmMoveOnBoard(wstring sourceFileRank, wstring destFileRank
    Also return if the game can continue or not (i.e. no checkmate/stalemate)
 */
 bool ChessBoard::showMoveAndCheckIfGameCanContinue(Piece* piece,
-	wstring sourceFileRank, Piece* capturedPiece, wstring destFileRank,
-	bool isWhiteTurn, Board* board)
+	int sourceSquare, Piece* capturedPiece, int destSquare,
+	bool isWhiteTurn, Position* board)
 {
-	printMove(piece, sourceFileRank, destFileRank);
+	printMove(piece, sourceSquare, destSquare);
 	if (capturedPiece != NULL) {
 		printCapture(capturedPiece);
 	}
@@ -478,55 +444,21 @@ bool ChessBoard::showMoveAndCheckIfGameCanContinue(Piece* piece,
 	return true;
 }
 
-// Have a guess what it does :)
-void ChessBoard::switchPlayers()
-{
-	_isWhiteTurn = !(_isWhiteTurn);
-}
-
-// Deep clone the given board - including all the Piece within the map
-Board* ChessBoard::cloneBoard(Board* board)
-{
-
-	Board* clone = new Board;
-	for (Board::iterator it = board->begin(); it != board->end(); it++)
-	{
-		clone->insert({ it->first, it->second->clone() });
-	}
-	return clone;
-}
-
-/* deepCleanBoard ():
-   deep clean the given board, free all containing Piece's memory and itself
-*/
-void ChessBoard::deepCleanBoard(Board* board)
-{
-
-	for (Board::iterator it = board->begin(); it != board->end(); it++)
-	{
-		delete it->second;
-	}
-	delete board;
-}
-
 /* print(Move|Capture|Check|Checkmate|Stalemate) ():
    Print in stdout with structured as specified in comments for
 	 showMoveAndCheckIfGameCanContinue ()
 */
-void ChessBoard::printMove(Piece* movingPiece, wstring sourceFileRank, wstring destFileRank)
+void ChessBoard::printMove(Piece* movingPiece, int sourceSquare, int destSquare)
 {
 
 	/* cout << movingPiece->toString() << " moves from "
 		<< sourceFileRank << " to " << destFileRank; */
 	wstring strStatus = movingPiece->toString();
 	strStatus += _T(" moves from ");
-	strStatus += sourceFileRank;
+	strStatus += fileRankOf(sourceSquare);
 	strStatus += _T(" to ");
-	strStatus += destFileRank;
-	if (m_pColorStatic != nullptr)
-	{
-		m_pColorStatic->SetWindowText(strStatus.c_str());
-	}
+	strStatus += fileRankOf(destSquare);
+	setStatus(strStatus);
 }
 
 void ChessBoard::printCapture(Piece* capturedPiece)
@@ -534,27 +466,18 @@ void ChessBoard::printCapture(Piece* capturedPiece)
 	/*cout << " taking " << capturedPiece->toString(); */
 	wstring strStatus = _T(" taking ");
 	strStatus += capturedPiece->toString();
-	if (m_pColorStatic != nullptr)
-	{
-		CString strBuffer;
-		m_pColorStatic->GetWindowText(strBuffer);
-		strBuffer += strStatus.c_str();
-		m_pColorStatic->SetWindowText(strBuffer);
-	}
+	appendStatus(strStatus);
 }
 
 void ChessBoard::printCheck()
 {
 	/* cout << ", Check!"; */
 	wstring strStatus = _T(", Check!");
-	if (m_pColorStatic != nullptr)
+	appendStatus(strStatus);
+	if (m_pObserver != nullptr)
 	{
-		CString strBuffer;
-		m_pColorStatic->GetWindowText(strBuffer);
-		strBuffer += strStatus.c_str();
-		m_pColorStatic->SetWindowText(strBuffer);
+		m_pObserver->alert();
 	}
-	MessageBeep(MB_ICONEXCLAMATION);
 }
 
 void ChessBoard::printCheckmate(bool isWhiteTurn)
@@ -564,32 +487,41 @@ void ChessBoard::printCheckmate(bool isWhiteTurn)
 	wstring strStatus = _T(" Checkmate! ");
 	strStatus += (isWhiteTurn ? _T("White") : _T("Black"));
 	strStatus += _T(" loses.");
-	if (m_pColorStatic != nullptr)
+	appendStatus(strStatus);
+	if (m_pObserver != nullptr)
 	{
-		CString strBuffer;
-		m_pColorStatic->GetWindowText(strBuffer);
-		strBuffer += strStatus.c_str();
-		m_pColorStatic->SetWindowText(strBuffer);
+		m_pObserver->alert();
 	}
-	MessageBeep(MB_ICONEXCLAMATION);
 }
 
 void ChessBoard::printStalemate()
 {
 	/* cout << "Stalemate." << endl; */
 	wstring strStatus = _T(" Stalemate.");
-	if (m_pColorStatic != nullptr)
+	appendStatus(strStatus);
+	if (m_pObserver != nullptr)
+	{
+		m_pObserver->alert();
+	}
+}
+
+// The status line, shown by the observer if there is one
+void ChessBoard::setStatus(const wstring& status)
+{
+	_status = status;
+	if (m_pObserver != nullptr)
 	{
-		CString strBuffer;
-		m_pColorStatic->GetWindowText(strBuffer);
-		strBuffer += strStatus.c_str();
-		m_pColorStatic->SetWindowText(strBuffer);
+		m_pObserver->statusChanged(_status);
 	}
-	MessageBeep(MB_ICONEXCLAMATION);
+}
+
+void ChessBoard::appendStatus(const wstring& status)
+{
+	setStatus(_status + status);
 }
 
 // Printing the state of the chessboard in unicode (graphic) representation
-void ChessBoard::printBoard(Board* board)
+void ChessBoard::printBoard(Position* board)
 {
 	UNREFERENCED_PARAMETER(board);
 	/* cout << endl << "  +--+--+--+--+--+--+--+--+" << endl;
@@ -599,15 +531,13 @@ void ChessBoard::printBoard(Board* board)
 		for (TCHAR j = ChessInfo::MIN_FILE; j <= ChessInfo::MAX_FILE; j++)
 		{
 			cout << "|";
-			wstring fileRank({ j, i });
-			try
+			Piece* piece = board->pieceAt(makeSquare(j - ChessInfo::MIN_FILE, i - ChessInfo::MIN_RANK));
+			if (piece != nullptr)
 			{
-				Piece* piece = board->at(fileRank);
 				cout << piece->toGraphics() << " ";
 			}
-			catch (const std::out_of_range& err)
+			else
 			{
-				UNREFERENCED_PARAMETER(err);
 				cout << "  ";
 			}
 		}
@@ -5,13 +5,13 @@
 #ifndef CHESSBOARD_H
 #define CHESSBOARD_H
 
-#include <map>
 #include <iostream>
 #include <string>
-#include <stdexcept>
 
 #include "ChessErrHandler.hpp"
 #include "ChessInfo.hpp"
+#include "Position.hpp"
+#include "MoveGen.hpp"
 
 #include "Piece.hpp"
 #include "EmptyPiece.hpp"
@@ -21,45 +21,72 @@
 #include "Rook.hpp"
 #include "Knight.hpp"
 #include "Pawn.hpp"
+#include "Search.hpp"
+
+#include <atomic>
+#include <thread>
 
 using namespace std;
 
-/* Improving clarity - the map of wstring (file & rank) to (ref. to) Piece would
-					   be simply known as Board (as it represents a board)
+/* ChessBoardObserver:
+   What the game reports to whoever shows it (the chess control, or nothing
+	 at all when the engine runs headless): the status line changed, a
+	 check/checkmate/stalemate deserves an alert, the computer player started
+	 or finished thinking (called from the computer player's thread)
 */
-typedef map<wstring, Piece*> Board;
+class ChessBoardObserver {
 
-class CChessCtrl;
+public:
+	virtual ~ChessBoardObserver() {}
+	virtual void statusChanged(const wstring& status) = 0;
+	virtual void alert() = 0;
+	virtual void computerThinking(bool isThinking) = 0;
+};
 
 class ChessBoard {
 
 	/* Contains knowledge of:
-	   board - situation of chess board at that instant
+	   board - situation of chess board at that instant (incl. side to move)
 	   errorHander - an error handler to handle invalid submitted moves
 	   piecePlaceholder - a Null Piece (EmptyPiece) for those who might need it
 	   boolean flags - obvious in function by their names, right?
 	*/
 public:
-	CChessCtrl* m_pParentWnd;
-	CStatic* m_pColorStatic;
-	CProgressCtrl* m_ctrlProgress;
-	Board* _board;
-	bool IsWhiteTurn() { return _isWhiteTurn;  }
+	ChessBoardObserver* m_pObserver;
+	Position _board;
+	bool IsWhiteTurn() { return _board.isWhiteTurn;  }
 	bool HasGameEnded() { return _hasEnded;  }
+	const wstring& getStatus() { return _status; }
+
+	/* Non-throwing square lookups on the current board:
+	   pieceAt() returns nullptr and isEmpty() returns true for a square
+		 without a piece (or a square which is not on the board)
+	*/
+	Piece* pieceAt(int square) { return _board.pieceAt(square); }
+	bool isEmpty(int square) { return _board.isEmpty(square); }
 private:
 	ChessErrHandler* errorHandler;
 	Piece* piecePlaceholder;
 
-	bool _isWhiteTurn = true;
 	bool _isInCheck = false;
 	bool _hasEnded = false;
+	wstring _status;
 
 public:
 	ChessBoard();
 	~ChessBoard();
 
 	void resetBoard();
+
+	/* Set up the game from a FEN string (see Position::loadFEN()), the game
+		 being over at once if the side to move has no legal move; return
+		 false, leaving the game as it was, if fen is malformed or impossible
+	   toFEN() describes the current position the same way
+	*/
+	bool loadFEN(const char* fen);
+	string toFEN() { return _board.toFEN(); }
 	void submitMove(const TCHAR* fromSquare, const TCHAR* toSquare);
+	void submitMove(Move move);
 
 private:
 	/* Pre-defined setter of the boolean flags, internal use only
@@ -82,10 +109,10 @@ private:
 	bool gameCanContinue(wstring sourceFileRank, wstring destFileRank);
 	bool sourceAndDestIsValid(wstring sourceFileRank, wstring destFileRank);
 	bool withinChessBoard(wstring fileRank);
-	bool sourceIsNotEmpty(wstring sourceFileRank, Board* board);
-	bool isCurrentPlayerPiece(bool isWhiteTurn, Piece* piece, wstring sourceFileRank);
-	bool pieceMoveIsValid(int returnCode, Piece* piece, wstring sourceFileRank, wstring destFileRank);
-	bool pieceMoveKeepsKingSafe(bool isWhiteTurn, Piece* piece, wstring sourceFileRank, wstring destFileRank, Board* sandboxBoard);
+	bool sourceIsNotEmpty(int sourceSquare, Position* board);
+	bool isCurrentPlayerPiece(bool isWhiteTurn, Piece* piece, int sourceSquare);
+	bool pieceMoveIsValid(int returnCode, Piece* piece, int sourceSquare, int destSquare);
+	bool pieceMoveKeepsKingSafe(bool isWhiteTurn, Piece* piece, int sourceSquare, int destSquare, Position* sandboxBoard);
 
 	// Responsible in calling the handler to print out *helpful* error messages
 	void handleInvalidMove(int returnCode, Piece* piece, wstring sourceFileRank, wstring destFileRank);
@@ -94,38 +121,58 @@ private:
 	   Checks if the given side's king is safe from rivalry on given board,
 		 and if the given side have valid move based on given board
 	*/
-	bool kingIsSafeFromRivalry(bool isWhiteTurn, Board* board);
-	bool playerHaveValidMove(bool isWhiteTurn, Board* board);
-	wstring findPlayersKingFileRank(bool isWhiteTurn, Board* board);
+	bool kingIsSafeFromRivalry(bool isWhiteTurn, Position* board);
+	bool playerHaveValidMove(bool isWhiteTurn, Position* board);
+	int findPlayersKingSquare(bool isWhiteTurn, Position* board);
 
 	/* In-move methods that make side-effect on chess board:
-	   Move the piece on source file and rank on a given board as in how one does
-		 in real life (Method differs in if it returns the captured piece or not)
+	   Play the move on a given board as in how one does in real life, the
+		 turn passing to the other side, take it back if it turns out to be
+		 invalid, or confirm it
 	*/
-	Piece* tryMoveAndReturnCaptured(wstring sourceFileRank, wstring destFileRank, Board* board);
-	void confirmMoveOnBoard(wstring sourceFileRank, wstring destFileRank, Board* board);
-
-	// Doesn't require much explanation for the following three methods right?
-	void switchPlayers();
-
-	Board* cloneBoard(Board* board);
-	void deepCleanBoard(Board* board);
+	Piece* tryMoveAndReturnCaptured(Move move, Position* board, UndoRecord& undo);
+	void takeBackMove(Move move, Position* board, const UndoRecord& undo);
+	void confirmMoveOnBoard();
 
 	// Printing methods, in both text and graphics, on stdout
-	bool showMoveAndCheckIfGameCanContinue(Piece* piece, wstring sourceFileRank, Piece* capturedPiece, wstring destFileRank, bool isWhiteTurn, Board* board);
+	bool showMoveAndCheckIfGameCanContinue(Piece* piece, int sourceSquare, Piece* capturedPiece, int destSquare, bool isWhiteTurn, Position* board);
 
-	void printMove(Piece* piece, wstring sourceFileRank, wstring destFileRank);
+	void printMove(Piece* piece, int sourceSquare, int destSquare);
 	void printCapture(Piece* capturedPiece);
 	void printCheck();
 	void printCheckmate(bool isWhitePlayer);
 	void printStalemate();
+	void setStatus(const wstring& status);
+	void appendStatus(const wstring& status);
 
-	void printBoard(Board* board);
+	void printBoard(Position* board);
 
 public:
-	DWORD m_nComputerThreadID;
-	HANDLE m_hComputerThread;
+	SearchLimits m_searchLimits;
+	TranspositionTable m_transpositionTable;
+	int m_searchThreads;
+
+	/* The computer player searches the current position on its own thread
+		 and plays the best move it finds: ComputerPlayer() starts it (after
+		 waiting for the previous one), StopComputerPlayer() cuts its search
+		 short, without playing, and WaitComputerPlayer() waits for the
+		 thread to finish
+	   N.B.: The observer is called from that thread: a UI thread waiting for
+			 it should keep its messages flowing until IsComputerThinking()
+			 turns false, and only then wait
+	*/
 	void ComputerPlayer();
+	void StopComputerPlayer();
+	void WaitComputerPlayer();
+	bool IsComputerThinking() { return m_bComputerThinking; }
+private:
+	void ComputerThreadProc();
+	thread m_computerThread;
+	atomic<bool> m_bComputerThinking;
+	atomic<bool> m_bStopSearch;
+
+	// Kept from one move to the next, with its caches and helper threads
+	Search m_computerSearch;
 };
 
 #endif
@@ -41,6 +41,7 @@ CChessCtrl::CChessCtrl()
 	m_bChessPiece = false;
 	m_nPreviousPoint = CPoint(-1, -1);
 	m_nCurrentSquare = CPoint(-1, -1);
+	m_nMoveFrom = ChessInfo::NO_SQUARE;
 	m_bComputerPlayer = false;
 }
 
@@ -251,21 +252,13 @@ void CChessCtrl::OnPaint()
 	{
 		for (TCHAR j = ChessInfo::MIN_FILE; j <= ChessInfo::MAX_FILE; j++)
 		{
-			try
+			Piece* piece = m_pChessBoard.pieceAt(makeSquare(j - ChessInfo::MIN_FILE, i - ChessInfo::MIN_RANK));
+			if (piece != nullptr)
 			{
-				wstring fileRank({ j, i });
-				Piece* piece = m_pChessBoard._board->at(fileRank);
-				if (piece != nullptr)
-				{
-					const int nOffsetX = pRect.Width() - m_nAdjustmentX - (2 + (ChessInfo::MAX_FILE - j)) * m_nSquareLength;
-					const int nOffsetY = pRect.Height() - m_nAdjustmentY - (2 + (i - ChessInfo::MIN_RANK)) * m_nSquareLength;
-					CRect pTextRect(CPoint(nOffsetX, nOffsetY), CSize(m_nSquareLength, m_nSquareLength));
-					pDC.DrawText(piece->toGraphics().c_str(), pTextRect, DT_CENTER | DT_VCENTER | DT_SINGLELINE);
-				}
-			}
-			catch (const std::out_of_range& err)
-			{
-				UNREFERENCED_PARAMETER(err);
+				const int nOffsetX = pRect.Width() - m_nAdjustmentX - (2 + (ChessInfo::MAX_FILE - j)) * m_nSquareLength;
+				const int nOffsetY = pRect.Height() - m_nAdjustmentY - (2 + (i - ChessInfo::MIN_RANK)) * m_nSquareLength;
+				CRect pTextRect(CPoint(nOffsetX, nOffsetY), CSize(m_nSquareLength, m_nSquareLength));
+				pDC.DrawText(piece->toGraphics().c_str(), pTextRect, DT_CENTER | DT_VCENTER | DT_SINGLELINE);
 			}
 		}
 	}
@@ -337,51 +330,57 @@ void CChessCtrl::OnMouseMove(UINT nFlags, CPoint point)
 
 void CChessCtrl::OnLButtonDown(UINT nFlags, CPoint point)
 {
-	if ((m_pChessBoard.IsWhiteTurn() || !m_bComputerPlayer) && !m_pChessBoard.HasGameEnded())
+	// N.B.: the computer player's thread may still be repainting after its move
+	if ((m_pChessBoard.IsWhiteTurn() || !m_bComputerPlayer) && !m_pChessBoard.HasGameEnded() &&
+		!m_pChessBoard.IsComputerThinking())
 	{
 		if ((m_nCurrentSquare.x >= 0) && (m_nCurrentSquare.x <= 7) &&
 			(m_nCurrentSquare.y >= 0) && (m_nCurrentSquare.y <= 7))
 		{
 			if (!m_bChessPiece)
 			{
-				try
+				m_nMoveFrom = GetCurrentSquare();
+				if (!m_pChessBoard.isEmpty(m_nMoveFrom))
 				{
-					wstring fileRank({ (TCHAR)(ChessInfo::MIN_FILE + m_nCurrentSquare.x), (TCHAR)(ChessInfo::MAX_RANK - m_nCurrentSquare.y) });
-					Piece* piece = m_pChessBoard._board->at(fileRank);
-					m_strMoveFrom = fileRank;
-					if (piece != nullptr)
-					{ 
-						m_bChessPiece = true;
-						RedrawWindow();
-						UpdateWindow();
-						if (m_pColorStatic != nullptr)
-						{
-							m_pColorStatic->RedrawWindow();
-							m_pColorStatic->UpdateWindow();
-						}
-						if (m_ctrlProgress != nullptr)
-						{
-							m_ctrlProgress->RedrawWindow();
-							m_ctrlProgress->UpdateWindow();
-						}
+					m_bChessPiece = true;
+					RedrawWindow();
+					UpdateWindow();
+					if (m_pColorStatic != nullptr)
+					{
+						m_pColorStatic->RedrawWindow();
+						m_pColorStatic->UpdateWindow();
+					}
+					if (m_ctrlProgress != nullptr)
+					{
+						m_ctrlProgress->RedrawWindow();
+						m_ctrlProgress->UpdateWindow();
 					}
-				}
-				catch (const std::out_of_range& err)
-				{
-					UNREFERENCED_PARAMETER(err);
 				}
 			}
 			else
 			{
 				m_bChessPiece = false;
 				// Move piece
-				try
+				m_pChessBoard.submitMove(createMove(m_nMoveFrom, GetCurrentSquare()));
+
+				RedrawWindow();
+				UpdateWindow();
+				if (m_pColorStatic != nullptr)
+				{
+					m_pColorStatic->RedrawWindow();
+					m_pColorStatic->UpdateWindow();
+				}
+				if (m_ctrlProgress != nullptr)
+				{
+					m_ctrlProgress->RedrawWindow();
+					m_ctrlProgress->UpdateWindow();
+				}
+
+				if (m_bComputerPlayer && !m_pChessBoard.IsWhiteTurn() && !m_pChessBoard.HasGameEnded())
 				{
-					wstring fileRank({ (TCHAR)(ChessInfo::MIN_FILE + m_nCurrentSquare.x), (TCHAR)(ChessInfo::MAX_RANK - m_nCurrentSquare.y) });
-					m_strMoveTo = fileRank;
-					m_pChessBoard.submitMove(m_strMoveFrom.c_str(), m_strMoveTo.c_str());
+					m_pChessBoard.ComputerPlayer();
 
-					RedrawWindow();
+					/* RedrawWindow();
 					UpdateWindow();
 					if (m_pColorStatic != nullptr)
 					{
@@ -392,29 +391,7 @@ void CChessCtrl::OnLButtonDown(UINT nFlags, CPoint point)
 					{
 						m_ctrlProgress->RedrawWindow();
 						m_ctrlProgress->UpdateWindow();
-					}
-
-					if (m_bComputerPlayer && !m_pChessBoard.IsWhiteTurn() && !m_pChessBoard.HasGameEnded())
-					{
-						m_pChessBoard.ComputerPlayer();
-
-						/* RedrawWindow();
-						UpdateWindow();
-						if (m_pColorStatic != nullptr)
-						{
-							m_pColorStatic->RedrawWindow();
-							m_pColorStatic->UpdateWindow();
-						}
-						if (m_ctrlProgress != nullptr)
-						{
-							m_ctrlProgress->RedrawWindow();
-							m_ctrlProgress->UpdateWindow();
-						}*/
-					}
-				}
-				catch (const std::out_of_range& err)
-				{
-					UNREFERENCED_PARAMETER(err);
+					}*/
 				}
 			}
 		}
@@ -423,20 +400,63 @@ void CChessCtrl::OnLButtonDown(UINT nFlags, CPoint point)
 	CStatic::OnLButtonDown(nFlags, point);
 }
 
-bool CChessCtrl::IsValidMove()
+void CChessCtrl::statusChanged(const wstring& status)
 {
-	try
+	if (m_pColorStatic != nullptr)
 	{
-		wstring fileRank({ (TCHAR)(ChessInfo::MIN_FILE + m_nCurrentSquare.x), (TCHAR)(ChessInfo::MAX_RANK - m_nCurrentSquare.y) });
-		Piece* piece = m_pChessBoard._board->at(m_strMoveFrom);
-		if (piece != nullptr)
-		{
-			return (ChessErrHandler::CHESS_NO_ERROR == piece->isValidMove(m_strMoveFrom, fileRank, m_pChessBoard._board));
-		}
+		m_pColorStatic->SetWindowText(status.c_str());
 	}
-	catch (const std::out_of_range& err)
+}
+
+void CChessCtrl::alert()
+{
+	MessageBeep(MB_ICONEXCLAMATION);
+}
+
+// Called from the computer player's thread
+void CChessCtrl::computerThinking(bool isThinking)
+{
+	if (m_ctrlProgress != nullptr)
 	{
-		UNREFERENCED_PARAMETER(err);
+		m_ctrlProgress->SetMarquee(isThinking, 30);
+	}
+	if (isThinking)
+	{
+		return;
+	}
+
+	RedrawWindow();
+	UpdateWindow();
+	if (m_pColorStatic != nullptr)
+	{
+		m_pColorStatic->RedrawWindow();
+		m_pColorStatic->UpdateWindow();
+	}
+	if (m_ctrlProgress != nullptr)
+	{
+		m_ctrlProgress->RedrawWindow();
+		m_ctrlProgress->UpdateWindow();
+	}
+}
+
+bool CChessCtrl::IsValidMove()
+{
+	const int nMoveTo = GetCurrentSquare();
+	Piece* piece = m_pChessBoard.pieceAt(m_nMoveFrom);
+	if ((piece != nullptr) && (nMoveTo != ChessInfo::NO_SQUARE))
+	{
+		return (ChessErrHandler::CHESS_NO_ERROR == piece->isValidMove(m_nMoveFrom, nMoveTo, &m_pChessBoard._board));
 	}
 	return false;
 }
+
+// Square under the mouse (the board is drawn with rank 8 at the top)
+int CChessCtrl::GetCurrentSquare()
+{
+	if ((m_nCurrentSquare.x < 0) || (m_nCurrentSquare.x >= ChessInfo::NUM_FILES) ||
+		(m_nCurrentSquare.y < 0) || (m_nCurrentSquare.y >= ChessInfo::NUM_RANKS))
+	{
+		return ChessInfo::NO_SQUARE;
+	}
+	return makeSquare(m_nCurrentSquare.x, ChessInfo::NUM_RANKS - 1 - m_nCurrentSquare.y);
+}
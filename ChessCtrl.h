@@ -19,7 +19,7 @@ ChessCtrl. If not, see <http://www.opensource.org/licenses/gpl-3.0.html>*/
 
 // CChessCtrl
 
-class CChessCtrl : public CStatic
+class CChessCtrl : public CStatic, public ChessBoardObserver
 {
 	DECLARE_DYNAMIC(CChessCtrl)
 
@@ -45,21 +45,35 @@ protected:
 	bool m_bChessPiece;
 	CPoint m_nPreviousPoint;
 	CPoint m_nCurrentSquare;
-	wstring m_strMoveFrom, m_strMoveTo;
+	int m_nMoveFrom;
 	bool m_bComputerPlayer;
 
 public:
 	void SetUI()
 	{
-		m_pChessBoard.m_pParentWnd = this;
-		m_pChessBoard.m_pColorStatic = m_pColorStatic;
-		m_pChessBoard.m_ctrlProgress = m_ctrlProgress;
+		m_pChessBoard.m_pObserver = this;
 		m_pChessBoard.resetBoard();
 	};
 	void SetComputerPlayer(bool bOnOff)
 	{
 		m_bComputerPlayer = bOnOff;
 	};
+	void SetComputerLimits(const SearchLimits& pLimits)
+	{
+		m_pChessBoard.m_searchLimits = pLimits;
+	};
+	void SetHashSize(int nMegabytes)
+	{
+		m_pChessBoard.m_transpositionTable.resize(nMegabytes);
+	};
+	void SetSearchThreads(int nThreads)
+	{
+		m_pChessBoard.m_searchThreads = nThreads;
+	};
+	// ChessBoardObserver
+	virtual void statusChanged(const wstring& status);
+	virtual void alert();
+	virtual void computerThinking(bool isThinking);
 protected:
 	virtual void PreSubclassWindow();
 	afx_msg void OnPaint();
@@ -67,6 +81,7 @@ protected:
 	afx_msg void OnMouseMove(UINT nFlags, CPoint point);
 	afx_msg void OnLButtonDown(UINT nFlags, CPoint point);
 	bool IsValidMove();
+	int GetCurrentSquare();
 
 	DECLARE_MESSAGE_MAP()
 };
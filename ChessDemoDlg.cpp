@@ -446,23 +446,36 @@ HCURSOR CChessDemoDlg::OnQueryDragIcon()
 	return static_cast<HCURSOR>(m_hIcon);
 }
 
-extern bool g_bThreadRunning;
-bool WaitWithMessageLoop(HANDLE hEvent, DWORD dwTimeout);
+// Keeps the messages flowing while the computer player finishes (it repaints the control)
+static void WaitWithMessageLoop(ChessBoard& pChessBoard)
+{
+	MSG msg;
+	while (pChessBoard.IsComputerThinking())
+	{
+		MsgWaitForMultipleObjects(0, nullptr, FALSE, 10, QS_ALLINPUT);
+		while (PeekMessage(&msg, NULL, NULL, NULL, PM_REMOVE))
+		{
+			TranslateMessage(&msg);
+			DispatchMessage(&msg);
+		}
+	}
+	pChessBoard.WaitComputerPlayer();
+}
 
 /**
  * @brief Handles the Cancel action (Escape key or close button).
  *
- * If the computer-player thread is still running, signals it to stop by
- * clearing g_bThreadRunning and waits for the thread to finish via a
- * message-pumping wait loop before delegating to the base class cancel handler.
+ * If the computer-player thread is still running, signals it to stop
+ * and waits for the thread to finish via a message-pumping wait loop
+ * before delegating to the base class cancel handler.
  */
 void CChessDemoDlg::OnCancel()
 {
-	if (g_bThreadRunning)  // computer player thread is still active
+	if (m_pChessCtrl.m_pChessBoard.IsComputerThinking())  // computer player thread is still active
 	{
-		g_bThreadRunning = false;  // signal the thread to exit its loop
+		m_pChessCtrl.m_pChessBoard.StopComputerPlayer();  // signal the search to unwind
 		// pump messages while waiting so the UI stays responsive during shutdown
-		VERIFY(WaitWithMessageLoop(m_pChessCtrl.m_pChessBoard.m_hComputerThread, INFINITE));
+		WaitWithMessageLoop(m_pChessCtrl.m_pChessBoard);
 	}
 	CDialogEx::OnCancel();  // proceed with normal dialog teardown
 }
@@ -1,7 +1,6 @@
 // Bryan Liu (chl312), Dept. of Computing, Imperial College London
 // ChessErrHandler.cpp - Implementation of ChessErrHandler
 
-#include "pch.h"
 #include "ChessErrHandler.hpp"
 
 ChessErrHandler::ChessErrHandler() {
@@ -5,6 +5,8 @@
 #ifndef CHESSINFO_H
 #define CHESSINFO_H
 
+#include "ChessPlatform.hpp"
+
 class ChessInfo {
 
 public:
@@ -22,6 +24,11 @@ public:
 	static const TCHAR MAX_RANK = '8';
 
 	static const int EXCLUSIVE_SHIFT = 1;
+
+	static const int NUM_FILES = 8;
+	static const int NUM_RANKS = 8;
+	static const int NUM_SQUARES = 64;
+	static const int NO_SQUARE = -1;
 };
 
 #endif
@@ -0,0 +1,39 @@
+/* Copyright (C) 2024-2026 Stefan-Mihai MOGA
+This file is part of ChessCtrl application developed by Stefan-Mihai MOGA.
+Fully featured Chess Control written in C++ with the help of the MFC library.
+
+ChessCtrl is free software: you can redistribute it and/or modify it
+under the terms of the GNU General Public License as published by the Open
+Source Initiative, either version 3 of the License, or any later version.
+
+ChessCtrl is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+ChessCtrl. If not, see <http://www.opensource.org/licenses/gpl-3.0.html>*/
+
+// ChessPlatform.hpp - Platform definitions of the engine
+/* The engine sources build without MFC (and without the precompiled header
+	 of the application): on Windows the text type comes from <tchar.h>, as
+	 the application is built for UNICODE; elsewhere TCHAR is a wchar_t and
+	 _T() makes a wide literal, so the engine always works with wstring
+*/
+
+#ifndef CHESSPLATFORM_H
+#define CHESSPLATFORM_H
+
+#ifdef _WIN32
+#include <tchar.h>
+#else
+typedef wchar_t TCHAR;
+#ifndef _T
+#define _T(x) L ## x
+#endif
+#endif
+
+#ifndef UNREFERENCED_PARAMETER
+#define UNREFERENCED_PARAMETER(P) (void)(P)
+#endif
+
+#endif
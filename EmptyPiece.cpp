@@ -1,10 +1,9 @@
 // Bryan Liu (chl312), Dept. of Computing, Imperial College London
 // EmptyPiece.cpp - Implementation of EmptyPiece, Null Object of Piece
 
-#include "pch.h"
 #include "EmptyPiece.hpp"
 
-EmptyPiece::EmptyPiece(bool isWhitePlayer) : Piece(isWhitePlayer)
+EmptyPiece::EmptyPiece(bool isWhitePlayer) : Piece(isWhitePlayer, NO_PIECE_TYPE)
 {
 }
 
@@ -12,16 +11,11 @@ EmptyPiece::~EmptyPiece()
 {
 }
 
-EmptyPiece* EmptyPiece::clone()
-{
-	return new EmptyPiece(this->isWhitePlayer());
-}
-
 // isValidMove(): return special code indicating it is an empty piece
-int EmptyPiece::isValidMove(wstring sourceFileRank, wstring destFileRank, map<wstring, Piece*>* board)
+int EmptyPiece::isValidMove(int sourceSquare, int destSquare, const Position* board)
 {
-	UNREFERENCED_PARAMETER(sourceFileRank);
-	UNREFERENCED_PARAMETER(destFileRank);
+	UNREFERENCED_PARAMETER(sourceSquare);
+	UNREFERENCED_PARAMETER(destSquare);
 	UNREFERENCED_PARAMETER(board);
 	return ChessErrHandler::MOVED_EMPTY_PIECE;
 }
@@ -40,3 +34,8 @@ int EmptyPiece::Score()
 {
 	return 0;
 }
+
+int EmptyPiece::EndgameScore()
+{
+	return 0;
+}
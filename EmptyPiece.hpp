@@ -2,14 +2,13 @@
 // EmptyPiece.hpp - EmptyPiece extending Piece
 
 /* The Concrete Implementation of Piece, utilising Null Object Pattern
-   Including concrete implementation of clone(), isValidMove(), toString()
+   Including concrete implementation of isValidMove(), toString()
 	 and toGraphics(), inherited from abstract superclass Piece
 */
 
 #ifndef EMPTYPIECE_H
 #define EMPTYPIECE_H
 
-#include <map>
 #include <string>
 
 #include "Piece.hpp"
@@ -21,13 +20,13 @@ class EmptyPiece : public Piece {
 public:
 	EmptyPiece(bool isWhitePlayer);
 	~EmptyPiece();
-	EmptyPiece* clone();
 
-	int isValidMove(wstring sourceFileRank, wstring destFileRank, map<wstring, Piece*>* board);
+	int isValidMove(int sourceSquare, int destSquare, const Position* board);
 	wstring toString();
 	wstring toGraphics();
 public:
 	int Score(); // Stefan-Mihai Moga
+	int EndgameScore();
 };
 
 #endif
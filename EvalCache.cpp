@@ -0,0 +1,59 @@
+/* Copyright (C) 2024-2026 Stefan-Mihai MOGA
+This file is part of ChessCtrl application developed by Stefan-Mihai MOGA.
+Fully featured Chess Control written in C++ with the help of the MFC library.
+
+ChessCtrl is free software: you can redistribute it and/or modify it
+under the terms of the GNU General Public License as published by the Open
+Source Initiative, either version 3 of the License, or any later version.
+
+ChessCtrl is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+ChessCtrl. If not, see <http://www.opensource.org/licenses/gpl-3.0.html>*/
+
+
+// EvalCache.cpp - Implementation of EvalCache (info in EvalCache.hpp)
+
+#include "EvalCache.hpp"
+
+// The bits of an entry holding the key, the others hold the score
+static const unsigned long long KEY_BITS = ~0xFFFFULL;
+
+// The entry count is rounded down to a power of two, indexed by the low bits of the key
+EvalCache::EvalCache(int entries)
+{
+	size_t entryCount = 1;
+	while ((int)entryCount * 2 <= entries)
+	{
+		entryCount *= 2;
+	}
+	_entries.reset(new std::atomic<unsigned long long>[entryCount]);
+	_mask = entryCount - 1;
+	clear();
+}
+
+bool EvalCache::probe(Key key, int& score) const
+{
+	unsigned long long entry = _entries[key & _mask].load(std::memory_order_relaxed);
+	if (((entry ^ key) & KEY_BITS) != 0)
+	{
+		return false;
+	}
+	score = (short)(unsigned short)(entry & 0xFFFF);
+	return true;
+}
+
+void EvalCache::store(Key key, int score)
+{
+	_entries[key & _mask].store((key & KEY_BITS) | (unsigned short)score, std::memory_order_relaxed);
+}
+
+void EvalCache::clear()
+{
+	for (Key index = 0; index <= _mask; index++)
+	{
+		_entries[index].store(0, std::memory_order_relaxed);
+	}
+}
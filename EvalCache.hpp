@@ -0,0 +1,58 @@
+/* Copyright (C) 2024-2026 Stefan-Mihai MOGA
+This file is part of ChessCtrl application developed by Stefan-Mihai MOGA.
+Fully featured Chess Control written in C++ with the help of the MFC library.
+
+ChessCtrl is free software: you can redistribute it and/or modify it
+under the terms of the GNU General Public License as published by the Open
+Source Initiative, either version 3 of the License, or any later version.
+
+ChessCtrl is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+ChessCtrl. If not, see <http://www.opensource.org/licenses/gpl-3.0.html>*/
+
+
+// EvalCache.hpp - Evaluation cache
+/* Remembers the static evaluation of the positions the search scored:
+	 the leaves of the negamax search and the quiescence search stand on the
+	 same positions again and again, and the evaluation (all the more with
+	 a neural network) is the cost per node most worth saving
+   The table is direct-mapped: the low bits of the Zobrist key select the
+	 one entry a position can take, replaced by whatever is stored there
+	 next; an entry is a single 64-bit word, the upper 48 bits of the key
+	 with the score in the low 16 bits, read and written atomically, so the
+	 search threads share it without any lock and never see half an entry
+   The score is the one evaluate() returned, for the side to move (which the
+	 key includes); the cache has to be cleared when the evaluation changes
+*/
+
+#ifndef EVALCACHE_H
+#define EVALCACHE_H
+
+#include <atomic>
+#include <memory>
+
+#include "Zobrist.hpp"
+
+static const int DEFAULT_EVAL_CACHE_ENTRIES = 131072;
+
+class EvalCache {
+
+public:
+	EvalCache(int entries = DEFAULT_EVAL_CACHE_ENTRIES);
+
+	// Copy the score of the position into score, false if there is none
+	bool probe(Key key, int& score) const;
+	void store(Key key, int score);
+
+	// N.B.: Not to be called during a search
+	void clear();
+
+private:
+	std::unique_ptr<std::atomic<unsigned long long>[]> _entries;
+	Key _mask;
+};
+
+#endif
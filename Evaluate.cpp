@@ -0,0 +1,332 @@
+/* Copyright (C) 2024-2026 Stefan-Mihai MOGA
+This file is part of ChessCtrl application developed by Stefan-Mihai MOGA.
+Fully featured Chess Control written in C++ with the help of the MFC library.
+
+ChessCtrl is free software: you can redistribute it and/or modify it
+under the terms of the GNU General Public License as published by the Open
+Source Initiative, either version 3 of the License, or any later version.
+
+ChessCtrl is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+ChessCtrl. If not, see <http://www.opensource.org/licenses/gpl-3.0.html>*/
+
+// Evaluate.cpp - Implementation of the static evaluation (info in Evaluate.hpp)
+
+#include "Evaluate.hpp"
+#include "Nnue.hpp"
+#include "Piece.hpp"
+#include <algorithm>
+
+int pieceSquareScores[NUM_GAME_PHASES][16][64];
+int piecePhases[16];
+
+/* Bonuses of the White pieces, in centipawns, as the board is seen from
+	 White: rank 8 on the first line, rank 1 on the last one
+*/
+static const int pawnMiddlegameBonus[64] = {
+	  0,   0,   0,   0,   0,   0,   0,   0,
+	 50,  50,  50,  50,  50,  50,  50,  50,
+	 10,  10,  20,  30,  30,  20,  10,  10,
+	  5,   5,  10,  25,  25,  10,   5,   5,
+	  0,   0,   0,  20,  20,   0,   0,   0,
+	  5,  -5, -10,   0,   0, -10,  -5,   5,
+	  5,  10,  10, -20, -20,  10,  10,   5,
+	  0,   0,   0,   0,   0,   0,   0,   0
+};
+
+// Passed or not, a Pawn is worth more the nearer it is to promotion
+static const int pawnEndgameBonus[64] = {
+	  0,   0,   0,   0,   0,   0,   0,   0,
+	 60,  60,  60,  60,  60,  60,  60,  60,
+	 35,  35,  35,  35,  35,  35,  35,  35,
+	 20,  20,  20,  20,  20,  20,  20,  20,
+	 10,  10,  10,  10,  10,  10,  10,  10,
+	  5,   5,   5,   5,   5,   5,   5,   5,
+	  0,   0,   0,   0,   0,   0,   0,   0,
+	  0,   0,   0,   0,   0,   0,   0,   0
+};
+
+static const int knightBonus[64] = {
+	-50, -40, -30, -30, -30, -30, -40, -50,
+	-40, -20,   0,   0,   0,   0, -20, -40,
+	-30,   0,  10,  15,  15,  10,   0, -30,
+	-30,   5,  15,  20,  20,  15,   5, -30,
+	-30,   0,  15,  20,  20,  15,   0, -30,
+	-30,   5,  10,  15,  15,  10,   5, -30,
+	-40, -20,   0,   5,   5,   0, -20, -40,
+	-50, -40, -30, -30, -30, -30, -40, -50
+};
+
+static const int bishopBonus[64] = {
+	-20, -10, -10, -10, -10, -10, -10, -20,
+	-10,   0,   0,   0,   0,   0,   0, -10,
+	-10,   0,   5,  10,  10,   5,   0, -10,
+	-10,   5,   5,  10,  10,   5,   5, -10,
+	-10,   0,  10,  10,  10,  10,   0, -10,
+	-10,  10,  10,  10,  10,  10,  10, -10,
+	-10,   5,   0,   0,   0,   0,   5, -10,
+	-20, -10, -10, -10, -10, -10, -10, -20
+};
+
+static const int rookBonus[64] = {
+	  0,   0,   0,   0,   0,   0,   0,   0,
+	  5,  10,  10,  10,  10,  10,  10,   5,
+	 -5,   0,   0,   0,   0,   0,   0,  -5,
+	 -5,   0,   0,   0,   0,   0,   0,  -5,
+	 -5,   0,   0,   0,   0,   0,   0,  -5,
+	 -5,   0,   0,   0,   0,   0,   0,  -5,
+	 -5,   0,   0,   0,   0,   0,   0,  -5,
+	  0,   0,   0,   5,   5,   0,   0,   0
+};
+
+static const int queenBonus[64] = {
+	-20, -10, -10,  -5,  -5, -10, -10, -20,
+	-10,   0,   0,   0,   0,   0,   0, -10,
+	-10,   0,   5,   5,   5,   5,   0, -10,
+	 -5,   0,   5,   5,   5,   5,   0,  -5,
+	  0,   0,   5,   5,   5,   5,   0,  -5,
+	-10,   5,   5,   5,   5,   5,   0, -10,
+	-10,   0,   5,   0,   0,   0,   0, -10,
+	-20, -10, -10,  -5,  -5, -10, -10, -20
+};
+
+// Sheltered behind its Pawns, the King keeps away from the centre
+static const int kingMiddlegameBonus[64] = {
+	-30, -40, -40, -50, -50, -40, -40, -30,
+	-30, -40, -40, -50, -50, -40, -40, -30,
+	-30, -40, -40, -50, -50, -40, -40, -30,
+	-30, -40, -40, -50, -50, -40, -40, -30,
+	-20, -30, -30, -40, -40, -30, -30, -20,
+	-10, -20, -20, -20, -20, -20, -20, -10,
+	 20,  20,   0,   0,   0,   0,  20,  20,
+	 20,  30,  10,   0,   0,  10,  30,  20
+};
+
+// With the rival army thinned out, the King joins the fight from the centre
+static const int kingEndgameBonus[64] = {
+	-50, -40, -30, -20, -20, -30, -40, -50,
+	-30, -20, -10,   0,   0, -10, -20, -30,
+	-30, -10,  20,  30,  30,  20, -10, -30,
+	-30, -10,  30,  40,  40,  30, -10, -30,
+	-30, -10,  30,  40,  40,  30, -10, -30,
+	-30, -10,  20,  30,  30,  20, -10, -30,
+	-30, -30,   0,   0,   0,   0, -30, -30,
+	-50, -30, -30, -30, -30, -30, -30, -50
+};
+
+// The pieces other than the Pawns and the King keep their bonus in the endgame
+static const int* const pieceBonus[NUM_GAME_PHASES][KING + 1] = {
+	{ nullptr, pawnMiddlegameBonus, knightBonus, bishopBonus, rookBonus, queenBonus, kingMiddlegameBonus },
+	{ nullptr, pawnEndgameBonus, knightBonus, bishopBonus, rookBonus, queenBonus, kingEndgameBonus }
+};
+
+static const int phaseWeights[KING + 1] = { 0, 0, 1, 1, 2, 4, 0 };
+
+static struct PieceSquareInitializer {
+	PieceSquareInitializer()
+	{
+		for (int type = PAWN; type <= KING; type++)
+		{
+			PieceCode white = makePieceCode((PieceType)type, true);
+			PieceCode black = makePieceCode((PieceType)type, false);
+			piecePhases[white] = piecePhases[black] = phaseWeights[type];
+			for (int phase = MIDDLEGAME; phase < NUM_GAME_PHASES; phase++)
+			{
+				Piece* piece = Piece::fromCode(white);
+				int material = type == KING ? 0 : (phase == MIDDLEGAME ? piece->Score() : piece->EndgameScore());
+				for (int square = 0; square < ChessInfo::NUM_SQUARES; square++)
+				{
+					// The tables read from rank 8 down: White's square a1 is their entry 56
+					int whiteEntry = square ^ 56;
+					int blackEntry = square;
+					pieceSquareScores[phase][white][square] = material + pieceBonus[phase][type][whiteEntry];
+					pieceSquareScores[phase][black][square] = -(material + pieceBonus[phase][type][blackEntry]);
+				}
+			}
+		}
+	}
+} pieceSquareInitializer;
+
+// Pawn structure terms: middlegame, endgame
+static const int DOUBLED_PAWN[NUM_GAME_PHASES] = { -10, -20 };
+static const int ISOLATED_PAWN[NUM_GAME_PHASES] = { -10, -15 };
+static const int BACKWARD_PAWN[NUM_GAME_PHASES] = { -8, -10 };
+// By rank, counted from the Pawn's own side
+static const int PASSED_PAWN[NUM_GAME_PHASES][ChessInfo::NUM_RANKS] = {
+	{ 0, 5, 10, 15, 25, 40, 60, 0 },
+	{ 0, 10, 20, 35, 60, 90, 130, 0 }
+};
+// Shelter of a Pawn in front of its King, on the second & third ranks
+static const int SHELTER_PAWN[2] = { 10, 5 };
+static const int SHELTER_MISSING = -5;
+
+/* Masks of the Pawn structure, by side (White 0, Black 1) and square:
+   forwardSquares - the squares ahead on the same file
+   passedSquares - the squares ahead on the same and the adjacent files,
+	 where a rival Pawn stops the Pawn from being passed
+   supportSquares - the squares on the adjacent files, level with the Pawn
+	 or behind it, where a friendly Pawn can defend it as it advances
+*/
+static Bitboard fileSquares[ChessInfo::NUM_FILES];
+static Bitboard adjacentFileSquares[ChessInfo::NUM_FILES];
+static Bitboard forwardSquares[2][64];
+static Bitboard passedSquares[2][64];
+static Bitboard supportSquares[2][64];
+
+static int relativeRank(int square, bool isWhitePlayer)
+{
+	return isWhitePlayer ? rankOf(square) : ChessInfo::NUM_RANKS - 1 - rankOf(square);
+}
+
+static struct PawnMaskInitializer {
+	PawnMaskInitializer()
+	{
+		for (int file = 0; file < ChessInfo::NUM_FILES; file++)
+		{
+			fileSquares[file] = EMPTY_BB;
+			for (int rank = 0; rank < ChessInfo::NUM_RANKS; rank++)
+			{
+				fileSquares[file] |= squareBB(makeSquare(file, rank));
+			}
+		}
+		for (int file = 0; file < ChessInfo::NUM_FILES; file++)
+		{
+			adjacentFileSquares[file] = (file > 0 ? fileSquares[file - 1] : EMPTY_BB) |
+				(file < ChessInfo::NUM_FILES - 1 ? fileSquares[file + 1] : EMPTY_BB);
+		}
+		for (int side = 0; side < 2; side++)
+		{
+			for (int square = 0; square < ChessInfo::NUM_SQUARES; square++)
+			{
+				forwardSquares[side][square] = passedSquares[side][square] = supportSquares[side][square] = EMPTY_BB;
+				for (int other = 0; other < ChessInfo::NUM_SQUARES; other++)
+				{
+					int ahead = side == 0 ? rankOf(other) - rankOf(square) : rankOf(square) - rankOf(other);
+					bool isSameFile = fileOf(other) == fileOf(square);
+					bool isAdjacentFile = testSquare(adjacentFileSquares[fileOf(square)], other);
+					if (ahead > 0 && isSameFile)
+					{
+						forwardSquares[side][square] |= squareBB(other);
+					}
+					if (ahead > 0 && (isSameFile || isAdjacentFile))
+					{
+						passedSquares[side][square] |= squareBB(other);
+					}
+					if (ahead <= 0 && isAdjacentFile)
+					{
+						supportSquares[side][square] |= squareBB(other);
+					}
+				}
+			}
+		}
+	}
+} pawnMaskInitializer;
+
+/* Pawn structure terms of one side, from its point of view: a Pawn is
+	 doubled behind a friendly Pawn on its file; isolated without friendly
+	 Pawns on the adjacent files; backward if none of them can defend it and
+	 a rival Pawn guards the square in front of it; passed if no rival Pawn
+	 stands ahead on its own or an adjacent file
+*/
+static void evaluateSidePawns(const Position* board, bool isWhite, int score[NUM_GAME_PHASES],
+	signed char shelter[3])
+{
+	int side = isWhite ? 0 : 1;
+	Bitboard ownPawns = board->piecesOf(PAWN, isWhite);
+	Bitboard rivalPawns = board->piecesOf(PAWN, !isWhite);
+	int forward = isWhite ? ChessInfo::NUM_FILES : -ChessInfo::NUM_FILES;
+
+	Bitboard pawns = ownPawns;
+	while (pawns != EMPTY_BB)
+	{
+		int square = popLsb(pawns);
+		int file = fileOf(square);
+		bool isDoubled = (forwardSquares[side][square] & ownPawns) != EMPTY_BB;
+		bool isIsolated = (adjacentFileSquares[file] & ownPawns) == EMPTY_BB;
+		bool isPassed = !isDoubled && (passedSquares[side][square] & rivalPawns) == EMPTY_BB;
+		int stopSquare = square + forward;
+		bool isBackward = !isIsolated && !isPassed &&
+			(supportSquares[side][square] & ownPawns) == EMPTY_BB &&
+			(pawnAttacks(stopSquare, isWhite) & rivalPawns) != EMPTY_BB;
+
+		for (int phase = MIDDLEGAME; phase < NUM_GAME_PHASES; phase++)
+		{
+			score[phase] += (isDoubled ? DOUBLED_PAWN[phase] : 0) +
+				(isIsolated ? ISOLATED_PAWN[phase] : 0) +
+				(isBackward ? BACKWARD_PAWN[phase] : 0) +
+				(isPassed ? PASSED_PAWN[phase][relativeRank(square, isWhite)] : 0);
+		}
+	}
+
+	// Files A-C, D-E and F-H in front of a King there
+	static const int wingFiles[3][2] = { { 0, 2 }, { 3, 4 }, { 5, 7 } };
+	for (int wing = 0; wing < 3; wing++)
+	{
+		int wingShelter = 0;
+		for (int file = wingFiles[wing][0]; file <= wingFiles[wing][1]; file++)
+		{
+			Bitboard filePawns = fileSquares[file] & ownPawns;
+			int rank = filePawns != EMPTY_BB ?
+				relativeRank(isWhite ? lsbSquare(filePawns) : msbSquare(filePawns), isWhite) : 0;
+			wingShelter += (rank == 1 || rank == 2) ? SHELTER_PAWN[rank - 1] : SHELTER_MISSING;
+		}
+		shelter[wing] = (signed char)wingShelter;
+	}
+}
+
+void evaluatePawns(const Position* board, PawnEntry& entry)
+{
+	int white[NUM_GAME_PHASES] = { 0, 0 };
+	int black[NUM_GAME_PHASES] = { 0, 0 };
+	evaluateSidePawns(board, true, white, entry.shelter[0]);
+	evaluateSidePawns(board, false, black, entry.shelter[1]);
+	entry.key = board->pawnKey;
+	entry.middlegame = (short)(white[MIDDLEGAME] - black[MIDDLEGAME]);
+	entry.endgame = (short)(white[ENDGAME] - black[ENDGAME]);
+}
+
+// Shelter of the side's King, from the wing it stands on
+static int kingShelter(const Position* board, const PawnEntry& entry, bool isWhite)
+{
+	Bitboard king = board->piecesOf(KING, isWhite);
+	if (king == EMPTY_BB)
+	{
+		return 0;
+	}
+	int file = fileOf(lsbSquare(king));
+	int wing = file <= 2 ? 0 : (file <= 4 ? 1 : 2);
+	return entry.shelter[isWhite ? 0 : 1][wing];
+}
+
+int evaluate(const Position* board, PawnHash* pawnHash)
+{
+	// A position set up without both Kings is beyond the network
+	if (board->accumulator.network != nullptr && board->findKing(true) != ChessInfo::NO_SQUARE &&
+		board->findKing(false) != ChessInfo::NO_SQUARE)
+	{
+		return evaluateNetwork(board);
+	}
+
+	PawnEntry localEntry;
+	PawnEntry* entry = &localEntry;
+	if (pawnHash != nullptr)
+	{
+		entry = pawnHash->probe(board->pawnKey);
+	}
+	if (pawnHash == nullptr || entry->key != board->pawnKey)
+	{
+		evaluatePawns(board, *entry);
+	}
+
+	int middlegame = board->pieceSquareScore[MIDDLEGAME] + entry->middlegame +
+		kingShelter(board, *entry, true) - kingShelter(board, *entry, false);
+	int endgame = board->pieceSquareScore[ENDGAME] + entry->endgame;
+
+	// Promotions may bring more pieces than the game starts with
+	int phase = std::min(board->phase, MAX_PHASE);
+	int score = (middlegame * phase + endgame * (MAX_PHASE - phase)) / MAX_PHASE;
+	return board->isWhiteTurn ? score : -score;
+}
@@ -0,0 +1,71 @@
+/* Copyright (C) 2024-2026 Stefan-Mihai MOGA
+This file is part of ChessCtrl application developed by Stefan-Mihai MOGA.
+Fully featured Chess Control written in C++ with the help of the MFC library.
+
+ChessCtrl is free software: you can redistribute it and/or modify it
+under the terms of the GNU General Public License as published by the Open
+Source Initiative, either version 3 of the License, or any later version.
+
+ChessCtrl is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+ChessCtrl. If not, see <http://www.opensource.org/licenses/gpl-3.0.html>*/
+
+// Evaluate.hpp - Static evaluation
+/* A position is scored by the material on the board plus a piece-square
+	 bonus for every piece: central Knights, Pawns pushed forward, Rooks on
+	 the seventh rank, a castled King... are worth more than the bare piece
+   Every term has two weights, one for the middlegame and one for the
+	 endgame, and the score slides from the first to the second as the
+	 pieces come off: the game phase counts the pieces other than Pawns and
+	 Kings (a Knight or a Bishop 1, a Rook 2, a Queen 4), from MAX_PHASE
+	 with all of them on the board down to 0 with none, and the score is
+	 (middlegame * phase + endgame * (MAX_PHASE - phase)) / MAX_PHASE
+	 The King, above all, hides behind its Pawns in the middlegame and comes
+	 to the centre in the endgame
+   The material and bonus of each piece code on each square, for either
+	 phase, are held in one table: the piece's Score() or EndgameScore()
+	 plus its bonus on that square, negated for Black (the Black tables are
+	 the White ones mirrored); the Kings, always on the board, count only
+	 their bonus
+   The sums over the pieces, and the phase, are kept up to date by
+	 Position as the pieces are put on and taken off the board, as the
+	 Zobrist key is, so that evaluating a position costs no more than
+	 reading it
+   The Pawn structure is scored on top: doubled, isolated and backward
+	 Pawns lose, passed Pawns gain the more the further they are, and in
+	 the middlegame each King is worth its Pawn shelter; these terms depend
+	 on the Pawns alone and are looked up in a PawnHash by the pawn key,
+	 computed only for a skeleton not met before
+   While the position is bound to a neural network (Nnue.hpp), the network
+	 scores it instead of all the terms above
+*/
+
+#ifndef EVALUATE_H
+#define EVALUATE_H
+
+#include "PawnHash.hpp"
+
+struct Position;
+
+enum GamePhase { MIDDLEGAME = 0, ENDGAME, NUM_GAME_PHASES };
+
+static const int MAX_PHASE = 24;
+
+// Indexed by GamePhase, PieceCode (White 1-6, Black 9-14) and square, from White's point of view
+extern int pieceSquareScores[NUM_GAME_PHASES][16][64];
+
+// Indexed by PieceCode, what the piece adds to the game phase
+extern int piecePhases[16];
+
+/* The score of the position for the side to move, in centipawns, with the
+	 Pawn structure terms from pawnHash if given (computed afresh otherwise)
+*/
+int evaluate(const Position* board, PawnHash* pawnHash = nullptr);
+
+// Fill in the Pawn structure terms of the position (and the entry's key)
+void evaluatePawns(const Position* board, PawnEntry& entry);
+
+#endif
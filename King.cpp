@@ -1,46 +1,46 @@
 // Bryan Liu (chl312), Dept. of Computing, Imperial College London
 // King.cpp - implementation of King extending Piece (info in King.hpp)
 
-#include "pch.h"
 #include "King.hpp"
 
-King::King(bool isWhitePlayer) : Piece(isWhitePlayer)
+King::King(bool isWhitePlayer) : Piece(isWhitePlayer, KING)
 {
-	_isKing = true;
 }
 
 King::~King()
 {
 }
 
-King* King::clone()
-{
-	return new King(this->isWhitePlayer());
-}
-
 /* A King's move is valid if:
    - The destination is on its adjacent square
    - The (possibly) existing piece at destination is not a friendly
 	 (or destination is empty)
+   or if it castles (moves two files towards a Rook, see isValidCastling())
 
    King.isValidMove() post-cond: retrun 0 if move is valid as above
 								 respective error code otherwise
 */
-int King::isValidMove(wstring sourceFileRank, wstring destFileRank, map<wstring, Piece*>* board)
+int King::isValidMove(int sourceSquare, int destSquare, const Position* board)
 {
 
-	if (isSameFile(sourceFileRank, destFileRank) &&
-		isSameRank(sourceFileRank, destFileRank))
+	if (isSameFile(sourceSquare, destSquare) &&
+		isSameRank(sourceSquare, destSquare))
 	{
 		return ChessErrHandler::DEST_EQ_SOURCE;
 	}
 
-	if (!isAdjacentSquare(sourceFileRank, destFileRank))
+	const CastlingInfo* castling = findCastling(sourceSquare, destSquare);
+	if (castling != nullptr)
+	{
+		return isValidCastling(*castling, board);
+	}
+
+	if (!isAdjacentSquare(sourceSquare, destSquare))
 	{
 		return ChessErrHandler::ILLEGAL_MOVE_PATTERN;
 	}
 
-	if (destExistFriendlyPiece(destFileRank, board))
+	if (destExistFriendlyPiece(destSquare, board))
 	{
 		return ChessErrHandler::FRIENDLY_AT_DEST;
 	}
@@ -70,18 +70,48 @@ wstring King::toGraphics()
    pre-cond: args are valid file & rank representations of a different square
    post-cond: return true if the displacement of file and rank is at most 1
 */
-bool King::isAdjacentSquare(wstring sourceFileRank, wstring destFileRank)
+bool King::isAdjacentSquare(int sourceSquare, int destSquare)
 {
+	return testSquare(kingAttacks(sourceSquare), destSquare);
+}
 
-	TCHAR sourceFile = sourceFileRank.at(ChessInfo::FILE_INDEX);
-	TCHAR sourceRank = sourceFileRank.at(ChessInfo::RANK_INDEX);
-	TCHAR destFile = destFileRank.at(ChessInfo::FILE_INDEX);
-	TCHAR destRank = destFileRank.at(ChessInfo::RANK_INDEX);
+/* King.isValidCastling():
+   Castling is valid if:
+   - Neither the King nor the Rook has moved (the castling right is kept)
+   - There are no pieces between the King and the Rook
+   - The King is not in check and does not pass over an attacked square
+	 (landing in check is caught like for any other move)
+*/
+int King::isValidCastling(const CastlingInfo& castling, const Position* board)
+{
+	bool isWhiteCastling = castling.right == WHITE_KING_SIDE || castling.right == WHITE_QUEEN_SIDE;
+	if (isWhiteCastling != _isWhitePlayer || (board->castlingRights & castling.right) == 0 ||
+		board->squares[castling.rookFrom] != makePieceCode(ROOK, _isWhitePlayer))
+	{
+		return ChessErrHandler::ILLEGAL_MOVE_PATTERN;
+	}
 
-	return max(abs(destFile - sourceFile), abs(destRank - sourceRank)) == 1;
+	if (!board->castlingPathIsClear(castling))
+	{
+		return ChessErrHandler::OBSTRUCTION_EN_ROUTE;
+	}
+
+	int passedSquare = (castling.kingFrom + castling.kingTo) / 2;
+	if (board->isAttacked(castling.kingFrom, !_isWhitePlayer) ||
+		board->isAttacked(passedSquare, !_isWhitePlayer))
+	{
+		return ChessErrHandler::ALLOW_KING_IN_CHECK;
+	}
+
+	return ChessErrHandler::CHESS_NO_ERROR;
 }
 
 int King::Score()
 {
 	return 1000;
 }
+
+int King::EndgameScore()
+{
+	return 1000;
+}
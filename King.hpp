@@ -2,15 +2,15 @@
 // King.hpp - King extending Piece
 
 /* Represent Implementation of a King piece in chess
-   Including concrete implementation of clone(), isValidMove(), toString()
+   Including concrete implementation of isValidMove(), toString()
 	 and toGraphics(), inherited from abstract superclass Piece
-   Private method isAdjacentSquare() used in logic of validing move of a King
+   Private methods isAdjacentSquare() and isValidCastling() used in logic of
+	 validing move of a King
 */
 
 #ifndef KING_H
 #define KING_H
 
-#include <map>
 #include <string>
 
 #include "Piece.hpp"
@@ -20,16 +20,17 @@ class King : public Piece {
 public:
 	King(bool isWhitePlayer);
 	~King();
-	King* clone();
 
-	int isValidMove(wstring sourceFileRank, wstring destFileRank, map<wstring, Piece*>* board);
+	int isValidMove(int sourceSquare, int destSquare, const Position* board);
 	wstring toString();
 	wstring toGraphics();
 
 private:
-	bool isAdjacentSquare(wstring sourceFileRank, wstring destFileRank);
+	bool isAdjacentSquare(int sourceSquare, int destSquare);
+	int isValidCastling(const CastlingInfo& castling, const Position* board);
 public:
 	int Score(); // Stefan-Mihai Moga
+	int EndgameScore();
 };
 
 #endif
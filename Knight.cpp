@@ -1,10 +1,9 @@
 // Bryan Liu (chl312), Dept. of Computing, Imperial College London
 // Knight.cpp - implementation of Knight extending Piece (info in Knight.hpp)
 
-#include "pch.h"
 #include "Knight.hpp"
 
-Knight::Knight(bool isWhitePlayer) : Piece(isWhitePlayer)
+Knight::Knight(bool isWhitePlayer) : Piece(isWhitePlayer, KNIGHT)
 {
 }
 
@@ -12,11 +11,6 @@ Knight::~Knight()
 {
 }
 
-Knight* Knight::clone()
-{
-	return new Knight(this->isWhitePlayer());
-}
-
 /* A Knight's move is valid if:
    - It moves in "L"-pattern
    - The (possibly) existing piece on destination square is not a friendly
@@ -25,21 +19,21 @@ Knight* Knight::clone()
    Knight.isValidMove() post-cond: retrun 0 if move is valid as above
 								   respective error code otherwise
 */
-int Knight::isValidMove(wstring sourceFileRank, wstring destFileRank, map<wstring, Piece*>* board)
+int Knight::isValidMove(int sourceSquare, int destSquare, const Position* board)
 {
 
-	if (isSameFile(sourceFileRank, destFileRank) &&
-		isSameRank(sourceFileRank, destFileRank))
+	if (isSameFile(sourceSquare, destSquare) &&
+		isSameRank(sourceSquare, destSquare))
 	{
 		return ChessErrHandler::DEST_EQ_SOURCE;
 	}
 
-	if (!movesInLShape(sourceFileRank, destFileRank))
+	if (!movesInLShape(sourceSquare, destSquare))
 	{
 		return ChessErrHandler::ILLEGAL_MOVE_PATTERN;
 	}
 
-	if (destExistFriendlyPiece(destFileRank, board))
+	if (destExistFriendlyPiece(destSquare, board))
 	{
 		return ChessErrHandler::FRIENDLY_AT_DEST;
 	}
@@ -70,18 +64,17 @@ wstring Knight::toGraphics()
    pre-cond: args are valid file & rank representations of a different square
    post-cond: return true if abs file diff = 2(1) & abs rank diff = 1(2)
 */
-bool Knight::movesInLShape(wstring sourceFileRank, wstring destFileRank)
+bool Knight::movesInLShape(int sourceSquare, int destSquare)
 {
-
-	TCHAR sourceFile = sourceFileRank.at(ChessInfo::FILE_INDEX);
-	TCHAR sourceRank = sourceFileRank.at(ChessInfo::RANK_INDEX);
-	TCHAR destFile = destFileRank.at(ChessInfo::FILE_INDEX);
-	TCHAR destRank = destFileRank.at(ChessInfo::RANK_INDEX);
-
-	return abs(sourceFile - destFile) * abs(sourceRank - destRank) == 2;
+	return testSquare(knightAttacks(sourceSquare), destSquare);
 }
 
 int Knight::Score()
 {
-	return 10;
+	return 320;
+}
+
+int Knight::EndgameScore()
+{
+	return 300;
 }
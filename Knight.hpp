@@ -2,7 +2,7 @@
 // Knight.hpp - Knight extending Piece
 
 /* Represent Implementation of a Knight piece in chess
-   Including concrete implementation of clone(), isValidMove(), toString()
+   Including concrete implementation of isValidMove(), toString()
 	 and toGraphics(), inherited from abstract superclass Piece
    Private method movesInLShape() used in logic of validing move of a Knight
 */
@@ -10,7 +10,6 @@
 #ifndef KNIGHT_H
 #define KNIGHT_H
 
-#include <map>
 #include <string>
 
 #include "Piece.hpp"
@@ -20,16 +19,16 @@ class Knight : public Piece {
 public:
 	Knight(bool isWhitePlayer);
 	~Knight();
-	Knight* clone();
 
-	int isValidMove(wstring sourceFileRank, wstring destFileRank, map<wstring, Piece*>* board);
+	int isValidMove(int sourceSquare, int destSquare, const Position* board);
 	wstring toString();
 	wstring toGraphics();
 
 private:
-	bool movesInLShape(wstring sourceFileRank, wstring destFileRank);
+	bool movesInLShape(int sourceSquare, int destSquare);
 public:
 	int Score(); // Stefan-Mihai Moga
+	int EndgameScore();
 };
 
 #endif
@@ -0,0 +1,67 @@
+/* Copyright (C) 2024-2026 Stefan-Mihai MOGA
+This file is part of ChessCtrl application developed by Stefan-Mihai MOGA.
+Fully featured Chess Control written in C++ with the help of the MFC library.
+
+ChessCtrl is free software: you can redistribute it and/or modify it
+under the terms of the GNU General Public License as published by the Open
+Source Initiative, either version 3 of the License, or any later version.
+
+ChessCtrl is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+ChessCtrl. If not, see <http://www.opensource.org/licenses/gpl-3.0.html>*/
+
+// Move.hpp - Move
+/* A move packed in 16 bits, so that move lists, the transposition table and
+	 the history tables can hold plain integers:
+	   bits  0- 5: destination square
+	   bits  6-11: source square
+	   bits 12-13: PieceType promoted to, minus KNIGHT (promotions only)
+	   bits 14-15: MoveFlag
+   Special moves are flagged so that Position::makeMove() knows it has to
+	 also move the Rook (castling), take the Pawn beside the destination
+	 (en passant) or replace the Pawn (promotion)
+   NO_MOVE (A1 to A1) is never a real move and marks "no move"
+*/
+
+#ifndef MOVE_H
+#define MOVE_H
+
+enum MoveFlag { NORMAL_MOVE = 0, PROMOTION_MOVE, EN_PASSANT_MOVE, CASTLING_MOVE };
+
+typedef unsigned short Move;
+
+static const Move NO_MOVE = 0;
+
+// Promotions store the PieceType relative to KNIGHT (the lowest possible)
+static const int PROMOTION_BASE = 2;
+
+inline Move createMove(int from, int to, int flags = NORMAL_MOVE, int promotion = PROMOTION_BASE)
+{
+	return (Move)(to | (from << 6) | ((promotion - PROMOTION_BASE) << 12) | (flags << 14));
+}
+
+inline int moveFrom(Move move)
+{
+	return (move >> 6) & 0x3F;
+}
+
+inline int moveTo(Move move)
+{
+	return move & 0x3F;
+}
+
+inline int moveFlags(Move move)
+{
+	return move >> 14;
+}
+
+// The PieceType promoted to, only meaningful for a PROMOTION_MOVE
+inline int movePromotion(Move move)
+{
+	return ((move >> 12) & 0x3) + PROMOTION_BASE;
+}
+
+#endif
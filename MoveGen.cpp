@@ -0,0 +1,362 @@
+/* Copyright (C) 2024-2026 Stefan-Mihai MOGA
+This file is part of ChessCtrl application developed by Stefan-Mihai MOGA.
+Fully featured Chess Control written in C++ with the help of the MFC library.
+
+ChessCtrl is free software: you can redistribute it and/or modify it
+under the terms of the GNU General Public License as published by the Open
+Source Initiative, either version 3 of the License, or any later version.
+
+ChessCtrl is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+ChessCtrl. If not, see <http://www.opensource.org/licenses/gpl-3.0.html>*/
+
+// MoveGen.cpp - Implementation of the move generator (info in MoveGen.hpp)
+
+#include "MoveGen.hpp"
+#include <cstring>
+
+// One move per destination square
+static Move* addMoves(Move* moves, int sourceSquare, Bitboard targets)
+{
+	while (targets != EMPTY_BB)
+	{
+		*moves++ = createMove(sourceSquare, popLsb(targets));
+	}
+	return moves;
+}
+
+// Squares attacked by a piece other than a Pawn
+static Bitboard pieceAttacks(PieceType type, int square, Bitboard occupied)
+{
+	switch (type)
+	{
+		case KNIGHT: return knightAttacks(square);
+		case BISHOP: return bishopAttacks(square, occupied);
+		case ROOK: return rookAttacks(square, occupied);
+		case QUEEN: return queenAttacks(square, occupied);
+		case KING: return kingAttacks(square);
+		default: return EMPTY_BB;
+	}
+}
+
+// A Pawn reaching the last rank may become any of these
+static Move* addPromotions(Move* moves, int sourceSquare, int destSquare)
+{
+	*moves++ = createMove(sourceSquare, destSquare, PROMOTION_MOVE, QUEEN);
+	*moves++ = createMove(sourceSquare, destSquare, PROMOTION_MOVE, ROOK);
+	*moves++ = createMove(sourceSquare, destSquare, PROMOTION_MOVE, BISHOP);
+	*moves++ = createMove(sourceSquare, destSquare, PROMOTION_MOVE, KNIGHT);
+	return moves;
+}
+
+static Move* generatePawnMoves(const Position* board, Move* moves)
+{
+	bool isWhite = board->isWhiteTurn;
+	int forward = isWhite ? ChessInfo::NUM_FILES : -ChessInfo::NUM_FILES;
+	int initialRank = isWhite ? 1 : ChessInfo::NUM_RANKS - 2;
+	int lastRank = isWhite ? ChessInfo::NUM_RANKS - 1 : 0;
+	Bitboard rivals = board->piecesOf(!isWhite);
+	Bitboard empty = ~board->occupied();
+
+	Bitboard pawns = board->piecesOf(PAWN, isWhite);
+	while (pawns != EMPTY_BB)
+	{
+		int sourceSquare = popLsb(pawns);
+		Bitboard targets = pawnAttacks(sourceSquare, isWhite) & rivals;
+
+		int pushSquare = sourceSquare + forward;
+		if (testSquare(empty, pushSquare))
+		{
+			targets |= squareBB(pushSquare);
+			if (rankOf(sourceSquare) == initialRank && testSquare(empty, pushSquare + forward))
+			{
+				targets |= squareBB(pushSquare + forward);
+			}
+		}
+
+		while (targets != EMPTY_BB)
+		{
+			int destSquare = popLsb(targets);
+			if (rankOf(destSquare) == lastRank)
+			{
+				moves = addPromotions(moves, sourceSquare, destSquare);
+			}
+			else
+			{
+				*moves++ = createMove(sourceSquare, destSquare);
+			}
+		}
+
+		if (board->epSquare != ChessInfo::NO_SQUARE &&
+			testSquare(pawnAttacks(sourceSquare, isWhite), board->epSquare))
+		{
+			*moves++ = createMove(sourceSquare, board->epSquare, EN_PASSANT_MOVE);
+		}
+	}
+	return moves;
+}
+
+static Move* generateCastlings(const Position* board, Move* moves)
+{
+	bool isWhite = board->isWhiteTurn;
+	for (int index = 0; index < NUM_CASTLINGS; index++)
+	{
+		const CastlingInfo& castling = castlingInfos[index];
+		bool isWhiteCastling = castling.right == WHITE_KING_SIDE || castling.right == WHITE_QUEEN_SIDE;
+		if (isWhiteCastling != isWhite || !board->castlingPathIsClear(castling))
+		{
+			continue;
+		}
+
+		// The King may neither castle out of check nor pass over an attacked square
+		int passedSquare = (castling.kingFrom + castling.kingTo) / 2;
+		if (board->isAttacked(castling.kingFrom, !isWhite) ||
+			board->isAttacked(passedSquare, !isWhite))
+		{
+			continue;
+		}
+		*moves++ = createMove(castling.kingFrom, castling.kingTo, CASTLING_MOVE);
+	}
+	return moves;
+}
+
+/* generateMoves():
+   pre-cond.: moves has room for MAX_MOVES moves
+   Pawns first, then the other pieces looked up in the attack tables with
+	 friendly pieces removed from the destinations, castlings last
+*/
+int generateMoves(const Position* board, Move* moves)
+{
+	bool isWhite = board->isWhiteTurn;
+	Bitboard occupied = board->occupied();
+	Bitboard notFriendly = ~board->piecesOf(isWhite);
+	Move* end = generatePawnMoves(board, moves);
+
+	Bitboard pieces = board->piecesOf(isWhite) & ~board->byType[PAWN];
+	while (pieces != EMPTY_BB)
+	{
+		int sourceSquare = popLsb(pieces);
+		Bitboard targets = pieceAttacks(typeOf(board->squares[sourceSquare]), sourceSquare, occupied);
+		end = addMoves(end, sourceSquare, targets & notFriendly);
+	}
+
+	end = generateCastlings(board, end);
+	return (int)(end - moves);
+}
+
+static Move* generatePawnCaptures(const Position* board, Move* moves)
+{
+	bool isWhite = board->isWhiteTurn;
+	int forward = isWhite ? ChessInfo::NUM_FILES : -ChessInfo::NUM_FILES;
+	int lastRank = isWhite ? ChessInfo::NUM_RANKS - 1 : 0;
+	Bitboard rivals = board->piecesOf(!isWhite);
+
+	Bitboard pawns = board->piecesOf(PAWN, isWhite);
+	while (pawns != EMPTY_BB)
+	{
+		int sourceSquare = popLsb(pawns);
+		Bitboard targets = pawnAttacks(sourceSquare, isWhite) & rivals;
+
+		int pushSquare = sourceSquare + forward;
+		if (rankOf(pushSquare) == lastRank && board->isEmpty(pushSquare))
+		{
+			targets |= squareBB(pushSquare);
+		}
+
+		while (targets != EMPTY_BB)
+		{
+			int destSquare = popLsb(targets);
+			*moves++ = rankOf(destSquare) == lastRank ?
+				createMove(sourceSquare, destSquare, PROMOTION_MOVE, QUEEN) :
+				createMove(sourceSquare, destSquare);
+		}
+
+		if (board->epSquare != ChessInfo::NO_SQUARE &&
+			testSquare(pawnAttacks(sourceSquare, isWhite), board->epSquare))
+		{
+			*moves++ = createMove(sourceSquare, board->epSquare, EN_PASSANT_MOVE);
+		}
+	}
+	return moves;
+}
+
+/* generateCaptures():
+   pre-cond.: moves has room for MAX_MOVES moves
+   As generateMoves(), with the destinations limited to the rival pieces
+	 (and the promotion squares for the Pawns), no castling
+*/
+int generateCaptures(const Position* board, Move* moves)
+{
+	bool isWhite = board->isWhiteTurn;
+	Bitboard occupied = board->occupied();
+	Bitboard rivals = board->piecesOf(!isWhite);
+	Move* end = generatePawnCaptures(board, moves);
+
+	Bitboard pieces = board->piecesOf(isWhite) & ~board->byType[PAWN];
+	while (pieces != EMPTY_BB)
+	{
+		int sourceSquare = popLsb(pieces);
+		Bitboard targets = pieceAttacks(typeOf(board->squares[sourceSquare]), sourceSquare, occupied);
+		end = addMoves(end, sourceSquare, targets & rivals);
+	}
+	return (int)(end - moves);
+}
+
+bool isCaptureMove(const Position* board, Move move)
+{
+	switch (moveFlags(move))
+	{
+		case PROMOTION_MOVE: return movePromotion(move) == QUEEN;
+		case EN_PASSANT_MOVE: return true;
+		case CASTLING_MOVE: return false;
+		default: return board->squares[moveTo(move)] != NO_PIECE;
+	}
+}
+
+/* generateQuiets():
+   pre-cond.: moves has room for MAX_MOVES moves
+   The moves of generateMoves() which are not captures: it is only called
+	 once the captures failed to cut off, when generating everything again
+	 costs little next to searching the moves
+*/
+int generateQuiets(const Position* board, Move* moves)
+{
+	int count = generateMoves(board, moves);
+	int quietCount = 0;
+	for (int index = 0; index < count; index++)
+	{
+		if (!isCaptureMove(board, moves[index]))
+		{
+			moves[quietCount++] = moves[index];
+		}
+	}
+	return quietCount;
+}
+
+bool moveIsPseudoLegal(const Position* board, Move move)
+{
+	int from = moveFrom(move);
+	int to = moveTo(move);
+	PieceCode moving = board->squares[from];
+	bool isWhite = board->isWhiteTurn;
+	if (move == NO_MOVE || moving == NO_PIECE || isWhitePiece(moving) != isWhite ||
+		testSquare(board->piecesOf(isWhite), to))
+	{
+		return false;
+	}
+
+	if (moveFlags(move) == CASTLING_MOVE)
+	{
+		const CastlingInfo* castling = findCastling(from, to);
+		return castling != nullptr && typeOf(moving) == KING &&
+			board->castlingPathIsClear(*castling) &&
+			!board->isAttacked(castling->kingFrom, !isWhite) &&
+			!board->isAttacked((castling->kingFrom + castling->kingTo) / 2, !isWhite);
+	}
+
+	if (typeOf(moving) != PAWN)
+	{
+		return moveFlags(move) == NORMAL_MOVE &&
+			testSquare(pieceAttacks(typeOf(moving), from, board->occupied()), to);
+	}
+
+	if (moveFlags(move) == EN_PASSANT_MOVE)
+	{
+		return to == board->epSquare && testSquare(pawnAttacks(from, isWhite), to);
+	}
+
+	int lastRank = isWhite ? ChessInfo::NUM_RANKS - 1 : 0;
+	if ((moveFlags(move) == PROMOTION_MOVE) != (rankOf(to) == lastRank))
+	{
+		return false;
+	}
+
+	int forward = isWhite ? ChessInfo::NUM_FILES : -ChessInfo::NUM_FILES;
+	int initialRank = isWhite ? 1 : ChessInfo::NUM_RANKS - 2;
+	if (testSquare(pawnAttacks(from, isWhite), to))
+	{
+		return testSquare(board->piecesOf(!isWhite), to);
+	}
+	return board->isEmpty(to) && (to == from + forward ||
+		(to == from + 2 * forward && rankOf(from) == initialRank && board->isEmpty(from + forward)));
+}
+
+bool moveIsLegal(Position* board, Move move)
+{
+	bool isWhite = board->isWhiteTurn;
+	UndoRecord undo;
+	board->makeMove(move, undo);
+	int kingSquare = board->findKing(isWhite);
+	bool isLegal = kingSquare == ChessInfo::NO_SQUARE || !board->isAttacked(kingSquare, !isWhite);
+	board->unmakeMove(move, undo);
+	return isLegal;
+}
+
+// Pseudo-legal moves, with the ones leaving the King in check filtered out
+int generateLegalMoves(Position* board, Move* moves)
+{
+	int count = generateMoves(board, moves);
+	int legalCount = 0;
+	for (int index = 0; index < count; index++)
+	{
+		if (moveIsLegal(board, moves[index]))
+		{
+			moves[legalCount++] = moves[index];
+		}
+	}
+	return legalCount;
+}
+
+Move findMove(const Position* board, int sourceSquare, int destSquare, PieceType promotion)
+{
+	Move moves[MAX_MOVES];
+	int count = generateMoves(board, moves);
+	for (int index = 0; index < count; index++)
+	{
+		Move move = moves[index];
+		if (moveFrom(move) == sourceSquare && moveTo(move) == destSquare &&
+			(moveFlags(move) != PROMOTION_MOVE || movePromotion(move) == promotion))
+		{
+			return move;
+		}
+	}
+	return NO_MOVE;
+}
+
+Move parseMove(Position* board, const char* text)
+{
+	static const char promotionLetters[] = " pnbrqk";
+	int square[2];
+	for (int index = 0; index < 2; index++)
+	{
+		char file = text[2 * index];
+		char rank = file != '\0' ? text[2 * index + 1] : '\0';
+		if (file < 'a' || file > 'h' || rank < '1' || rank > '8')
+		{
+			return NO_MOVE;
+		}
+		square[index] = makeSquare(file - 'a', rank - '1');
+	}
+
+	PieceType promotion = QUEEN;
+	if (text[4] != '\0')
+	{
+		const char* letter = strchr(promotionLetters + 1, text[4]);
+		if (letter == nullptr || text[5] != '\0')
+		{
+			return NO_MOVE;
+		}
+		promotion = (PieceType)(letter - promotionLetters);
+	}
+
+	Move move = findMove(board, square[0], square[1], promotion);
+	if (move == NO_MOVE || (moveFlags(move) == PROMOTION_MOVE) != (text[4] != '\0') ||
+		!moveIsLegal(board, move))
+	{
+		return NO_MOVE;
+	}
+	return move;
+}
@@ -0,0 +1,68 @@
+/* Copyright (C) 2024-2026 Stefan-Mihai MOGA
+This file is part of ChessCtrl application developed by Stefan-Mihai MOGA.
+Fully featured Chess Control written in C++ with the help of the MFC library.
+
+ChessCtrl is free software: you can redistribute it and/or modify it
+under the terms of the GNU General Public License as published by the Open
+Source Initiative, either version 3 of the License, or any later version.
+
+ChessCtrl is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+ChessCtrl. If not, see <http://www.opensource.org/licenses/gpl-3.0.html>*/
+
+// MoveGen.hpp - Move generator
+/* Emits the moves of the side to move straight from the attack tables,
+	 into a buffer owned by the caller (room for MAX_MOVES moves, no chess
+	 position has more than 218 legal moves), and returns how many it wrote
+   Pseudo-legal moves follow the rules of each piece (castling, en passant
+	 and promotions included) but may leave the own King in check: castling
+	 is only generated when the King is not in check and does not pass over
+	 an attacked square, the destination is left to the legality test
+*/
+
+#ifndef MOVEGEN_H
+#define MOVEGEN_H
+
+#include "Position.hpp"
+
+static const int MAX_MOVES = 256;
+
+int generateMoves(const Position* board, Move* moves);
+int generateLegalMoves(Position* board, Move* moves);
+
+/* The pseudo-legal moves winning material: captures (en passant included)
+	 and promotions, only to a Queen, for the quiescence search
+*/
+int generateCaptures(const Position* board, Move* moves);
+
+// The pseudo-legal moves generateCaptures() leaves out
+int generateQuiets(const Position* board, Move* moves);
+
+// True for the moves generateCaptures() emits
+bool isCaptureMove(const Position* board, Move move);
+
+/* True if the move is one generateMoves() would emit in this position:
+	 checks a move from elsewhere (the transposition table, a killer move)
+	 without generating all the moves
+*/
+bool moveIsPseudoLegal(const Position* board, Move move);
+
+/* True if playing the (pseudo-legal) move does not leave the mover's King
+	 in check: the move is tried on the board and taken back
+*/
+bool moveIsLegal(Position* board, Move move);
+
+/* The pseudo-legal move from source to destination (promoting to the given
+	 PieceType if it is a promotion), NO_MOVE if there is none
+*/
+Move findMove(const Position* board, int sourceSquare, int destSquare, PieceType promotion);
+
+/* The legal move written in coordinate notation (as moveToString() writes
+	 it, e.g. "e2e4" or "e7e8q"), NO_MOVE if the text is not one
+*/
+Move parseMove(Position* board, const char* text);
+
+#endif
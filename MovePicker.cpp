@@ -0,0 +1,183 @@
+/* Copyright (C) 2024-2026 Stefan-Mihai MOGA
+This file is part of ChessCtrl application developed by Stefan-Mihai MOGA.
+Fully featured Chess Control written in C++ with the help of the MFC library.
+
+ChessCtrl is free software: you can redistribute it and/or modify it
+under the terms of the GNU General Public License as published by the Open
+Source Initiative, either version 3 of the License, or any later version.
+
+ChessCtrl is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+ChessCtrl. If not, see <http://www.opensource.org/licenses/gpl-3.0.html>*/
+
+// MovePicker.cpp - Implementation of MovePicker (info in MovePicker.hpp)
+
+#include "MovePicker.hpp"
+#include "Piece.hpp"
+
+int pieceValue(PieceCode code)
+{
+	return Piece::fromCode(code)->Score();
+}
+
+int captureGain(const Position* board, Move move)
+{
+	PieceCode victim = moveFlags(move) == EN_PASSANT_MOVE ?
+		makePieceCode(PAWN, !board->isWhiteTurn) : board->squares[moveTo(move)];
+	int gain = victim != NO_PIECE ? pieceValue(victim) : 0;
+	if (moveFlags(move) == PROMOTION_MOVE)
+	{
+		gain += pieceValue(makePieceCode(QUEEN, true));
+	}
+	return gain;
+}
+
+/* Most valuable victim first, and for the same victim the least valuable
+	 attacker first (a King is worth less than 1024)
+*/
+static int captureOrder(const Position* board, Move move)
+{
+	return captureGain(board, move) * 1024 - pieceValue(board->squares[moveFrom(move)]);
+}
+
+MovePicker::MovePicker(const Position* board, Move tableMove, const Move* killers, const int (*history)[64])
+{
+	_board = board;
+	_tableMove = tableMove;
+	for (int index = 0; index < NUM_KILLERS; index++)
+	{
+		_killers[index] = killers[index];
+	}
+	_history = history;
+	_capturesOnly = false;
+	_stage = TABLE_MOVE_STAGE;
+	_killerIndex = _current = _count = 0;
+}
+
+MovePicker::MovePicker(const Position* board)
+{
+	_board = board;
+	_tableMove = NO_MOVE;
+	for (int index = 0; index < NUM_KILLERS; index++)
+	{
+		_killers[index] = NO_MOVE;
+	}
+	_history = nullptr;
+	_capturesOnly = true;
+	_stage = GENERATE_CAPTURES;
+	_killerIndex = _current = _count = 0;
+}
+
+/* MovePicker.pickBest():
+   pre-cond.: _current < _count
+   Selection sort, one move at a time: a cut-off usually comes long before
+	 the whole list would have been sorted
+*/
+Move MovePicker::pickBest()
+{
+	int best = _current;
+	for (int index = _current + 1; index < _count; index++)
+	{
+		if (_scores[index] > _scores[best])
+		{
+			best = index;
+		}
+	}
+	Move move = _moves[best];
+	_moves[best] = _moves[_current];
+	_scores[best] = _scores[_current];
+	_current++;
+	return move;
+}
+
+bool MovePicker::isKiller(Move move) const
+{
+	for (int index = 0; index < NUM_KILLERS; index++)
+	{
+		if (_killers[index] == move)
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+Move MovePicker::next()
+{
+	while (true)
+	{
+		switch (_stage)
+		{
+			case TABLE_MOVE_STAGE:
+				_stage = GENERATE_CAPTURES;
+				if (_tableMove != NO_MOVE && moveIsPseudoLegal(_board, _tableMove))
+				{
+					return _tableMove;
+				}
+				break;
+
+			case GENERATE_CAPTURES:
+				_count = generateCaptures(_board, _moves);
+				for (int index = 0; index < _count; index++)
+				{
+					_scores[index] = captureOrder(_board, _moves[index]);
+				}
+				_current = 0;
+				_stage = CAPTURES;
+				break;
+
+			case CAPTURES:
+				while (_current < _count)
+				{
+					Move move = pickBest();
+					if (move != _tableMove)
+					{
+						return move;
+					}
+				}
+				_stage = _capturesOnly ? DONE : KILLERS;
+				break;
+
+			case KILLERS:
+				while (_killerIndex < NUM_KILLERS)
+				{
+					Move move = _killers[_killerIndex++];
+					if (move != NO_MOVE && move != _tableMove &&
+						!isCaptureMove(_board, move) && moveIsPseudoLegal(_board, move))
+					{
+						return move;
+					}
+				}
+				_stage = GENERATE_QUIETS;
+				break;
+
+			case GENERATE_QUIETS:
+				_count = generateQuiets(_board, _moves);
+				for (int index = 0; index < _count; index++)
+				{
+					_scores[index] = _history[moveFrom(_moves[index])][moveTo(_moves[index])];
+				}
+				_current = 0;
+				_stage = QUIETS;
+				break;
+
+			case QUIETS:
+				while (_current < _count)
+				{
+					Move move = pickBest();
+					if (move != _tableMove && !isKiller(move))
+					{
+						return move;
+					}
+				}
+				_stage = DONE;
+				break;
+
+			default:
+				return NO_MOVE;
+		}
+	}
+}
@@ -0,0 +1,78 @@
+/* Copyright (C) 2024-2026 Stefan-Mihai MOGA
+This file is part of ChessCtrl application developed by Stefan-Mihai MOGA.
+Fully featured Chess Control written in C++ with the help of the MFC library.
+
+ChessCtrl is free software: you can redistribute it and/or modify it
+under the terms of the GNU General Public License as published by the Open
+Source Initiative, either version 3 of the License, or any later version.
+
+ChessCtrl is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+ChessCtrl. If not, see <http://www.opensource.org/licenses/gpl-3.0.html>*/
+
+// MovePicker.hpp - Move picker
+/* Hands the moves of a position to the search one at a time, the most
+	 promising first, in stages:
+	 1. the move the transposition table found best here
+	 2. the captures, most valuable victim first and then least valuable
+		attacker first (MVV-LVA)
+	 3. the killer moves, quiet moves which caused a cut-off in a sibling
+		position (same ply) and are likely to do it again
+	 4. the other quiet moves, by their history score: how often and how
+		deep each (from, to) caused cut-offs elsewhere in the search
+   Each stage is only generated when the previous ones are done, so a node
+	 cut off by the table move or a capture never generates its quiet moves
+   Moves from the table or the killers are checked to be pseudo-legal
+	 here, every move still has to be checked for legality by the caller
+*/
+
+#ifndef MOVEPICKER_H
+#define MOVEPICKER_H
+
+#include "MoveGen.hpp"
+
+static const int NUM_KILLERS = 2;
+
+// Material value of a piece code, as its Piece's Score()
+int pieceValue(PieceCode code);
+
+// Material a capture (or promotion) wins if the piece is not taken back
+int captureGain(const Position* board, Move move);
+
+class MovePicker {
+
+public:
+	/* For the main search: history is the history table of the side to
+		 move, indexed by the move's source & destination squares
+	*/
+	MovePicker(const Position* board, Move tableMove, const Move* killers, const int (*history)[64]);
+
+	// For the quiescence search: the captures only
+	MovePicker(const Position* board);
+
+	// The next move to search, NO_MOVE once there are none left
+	Move next();
+
+private:
+	enum Stage { TABLE_MOVE_STAGE, GENERATE_CAPTURES, CAPTURES, KILLERS, GENERATE_QUIETS, QUIETS, DONE };
+
+	Move pickBest();
+	bool isKiller(Move move) const;
+
+	const Position* _board;
+	Move _tableMove;
+	Move _killers[NUM_KILLERS];
+	const int (*_history)[64];
+	bool _capturesOnly;
+	int _stage;
+	int _killerIndex;
+	int _current;
+	int _count;
+	Move _moves[MAX_MOVES];
+	int _scores[MAX_MOVES];
+};
+
+#endif
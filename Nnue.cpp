@@ -0,0 +1,607 @@
+/* Copyright (C) 2024-2026 Stefan-Mihai MOGA
+This file is part of ChessCtrl application developed by Stefan-Mihai MOGA.
+Fully featured Chess Control written in C++ with the help of the MFC library.
+
+ChessCtrl is free software: you can redistribute it and/or modify it
+under the terms of the GNU General Public License as published by the Open
+Source Initiative, either version 3 of the License, or any later version.
+
+ChessCtrl is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+ChessCtrl. If not, see <http://www.opensource.org/licenses/gpl-3.0.html>*/
+
+
+// Nnue.cpp - Implementation of the neural network evaluation (info in Nnue.hpp)
+
+#include "Nnue.hpp"
+#include "Position.hpp"
+#include <algorithm>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#if defined(_MSC_VER) && defined(_M_X64)
+#include <intrin.h>
+#include <immintrin.h>
+#define TARGET_AVX2
+#define TARGET_SSE41
+#elif defined(__GNUC__) && defined(__x86_64__)
+#include <cpuid.h>
+#include <immintrin.h>
+#define TARGET_AVX2 __attribute__((target("avx2")))
+#define TARGET_SSE41 __attribute__((target("sse4.1")))
+#else
+#define NNUE_NO_SIMD
+#endif
+
+static const int NNUE_INPUTS = 2 * NNUE_HALF_DIMENSIONS;
+// The dense layers' sums are scaled down by 2^WEIGHT_SCALE_BITS before clipping
+static const int WEIGHT_SCALE_BITS = 6;
+static const int MAX_ACTIVATION = 127;
+
+struct Network {
+	std::vector<short> transformerBiases;
+	std::vector<short> transformerWeights;
+	int hiddenBiases1[NNUE_HIDDEN];
+	alignas(32) signed char hiddenWeights1[NNUE_HIDDEN * NNUE_INPUTS];
+	int hiddenBiases2[NNUE_HIDDEN];
+	alignas(32) signed char hiddenWeights2[NNUE_HIDDEN * NNUE_HIDDEN];
+	int outputBias;
+	alignas(32) signed char outputWeights[NNUE_HIDDEN];
+};
+
+// The network loaded, whether it is switched on, and the lock over both
+static std::shared_ptr<const Network> loadedNetwork;
+static bool isNetworkOn = false;
+static std::mutex networkLock;
+
+enum Kernels { SCALAR_KERNELS, SSE41_KERNELS, AVX2_KERNELS };
+static Kernels kernels = SCALAR_KERNELS;
+
+/* Kernels:
+   addWeights() / subtractWeights() - one feature's weights into / out of
+	 an accumulator half
+   transformHalf() - an accumulator half clipped to 0..MAX_ACTIVATION, as
+	 the bytes fed to the first dense layer
+   affineLayer() - the sums of a dense layer: biases plus the weights (by
+	 output, then input) times the inputs, inputs a multiple of 32
+*/
+static void addWeightsScalar(short* values, const short* weights)
+{
+	for (int index = 0; index < NNUE_HALF_DIMENSIONS; index++)
+	{
+		values[index] += weights[index];
+	}
+}
+
+static void subtractWeightsScalar(short* values, const short* weights)
+{
+	for (int index = 0; index < NNUE_HALF_DIMENSIONS; index++)
+	{
+		values[index] -= weights[index];
+	}
+}
+
+static void transformHalfScalar(const short* values, unsigned char* output)
+{
+	for (int index = 0; index < NNUE_HALF_DIMENSIONS; index++)
+	{
+		output[index] = (unsigned char)std::clamp((int)values[index], 0, MAX_ACTIVATION);
+	}
+}
+
+static void affineLayerScalar(const unsigned char* input, int inputs, const signed char* weights,
+	const int* biases, int outputs, int* sums)
+{
+	for (int output = 0; output < outputs; output++)
+	{
+		const signed char* row = weights + output * inputs;
+		int sum = biases[output];
+		for (int index = 0; index < inputs; index++)
+		{
+			sum += row[index] * input[index];
+		}
+		sums[output] = sum;
+	}
+}
+
+#ifndef NNUE_NO_SIMD
+TARGET_SSE41
+static void addWeightsSse41(short* values, const short* weights)
+{
+	for (int index = 0; index < NNUE_HALF_DIMENSIONS; index += 8)
+	{
+		__m128i* value = (__m128i*)(values + index);
+		*value = _mm_add_epi16(*value, _mm_loadu_si128((const __m128i*)(weights + index)));
+	}
+}
+
+TARGET_SSE41
+static void subtractWeightsSse41(short* values, const short* weights)
+{
+	for (int index = 0; index < NNUE_HALF_DIMENSIONS; index += 8)
+	{
+		__m128i* value = (__m128i*)(values + index);
+		*value = _mm_sub_epi16(*value, _mm_loadu_si128((const __m128i*)(weights + index)));
+	}
+}
+
+TARGET_SSE41
+static void transformHalfSse41(const short* values, unsigned char* output)
+{
+	const __m128i zero = _mm_setzero_si128();
+	for (int index = 0; index < NNUE_HALF_DIMENSIONS; index += 16)
+	{
+		__m128i low = _mm_load_si128((const __m128i*)(values + index));
+		__m128i high = _mm_load_si128((const __m128i*)(values + index + 8));
+		__m128i packed = _mm_max_epi8(_mm_packs_epi16(low, high), zero);
+		_mm_storeu_si128((__m128i*)(output + index), packed);
+	}
+}
+
+TARGET_SSE41
+static void affineLayerSse41(const unsigned char* input, int inputs, const signed char* weights,
+	const int* biases, int outputs, int* sums)
+{
+	const __m128i ones = _mm_set1_epi16(1);
+	for (int output = 0; output < outputs; output++)
+	{
+		const signed char* row = weights + output * inputs;
+		__m128i sum = _mm_setzero_si128();
+		for (int index = 0; index < inputs; index += 16)
+		{
+			__m128i products = _mm_maddubs_epi16(_mm_loadu_si128((const __m128i*)(input + index)),
+				_mm_loadu_si128((const __m128i*)(row + index)));
+			sum = _mm_add_epi32(sum, _mm_madd_epi16(products, ones));
+		}
+		sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, _MM_SHUFFLE(1, 0, 3, 2)));
+		sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, _MM_SHUFFLE(2, 3, 0, 1)));
+		sums[output] = biases[output] + _mm_cvtsi128_si32(sum);
+	}
+}
+
+TARGET_AVX2
+static void addWeightsAvx2(short* values, const short* weights)
+{
+	for (int index = 0; index < NNUE_HALF_DIMENSIONS; index += 16)
+	{
+		__m256i* value = (__m256i*)(values + index);
+		*value = _mm256_add_epi16(*value, _mm256_loadu_si256((const __m256i*)(weights + index)));
+	}
+}
+
+TARGET_AVX2
+static void subtractWeightsAvx2(short* values, const short* weights)
+{
+	for (int index = 0; index < NNUE_HALF_DIMENSIONS; index += 16)
+	{
+		__m256i* value = (__m256i*)(values + index);
+		*value = _mm256_sub_epi16(*value, _mm256_loadu_si256((const __m256i*)(weights + index)));
+	}
+}
+
+// Packing works within each 128 bit lane, the permutation puts the bytes back in order
+TARGET_AVX2
+static void transformHalfAvx2(const short* values, unsigned char* output)
+{
+	const __m256i zero = _mm256_setzero_si256();
+	for (int index = 0; index < NNUE_HALF_DIMENSIONS; index += 32)
+	{
+		__m256i low = _mm256_load_si256((const __m256i*)(values + index));
+		__m256i high = _mm256_load_si256((const __m256i*)(values + index + 16));
+		__m256i packed = _mm256_max_epi8(_mm256_packs_epi16(low, high), zero);
+		packed = _mm256_permute4x64_epi64(packed, 0xD8);
+		_mm256_storeu_si256((__m256i*)(output + index), packed);
+	}
+}
+
+TARGET_AVX2
+static void affineLayerAvx2(const unsigned char* input, int inputs, const signed char* weights,
+	const int* biases, int outputs, int* sums)
+{
+	const __m256i ones = _mm256_set1_epi16(1);
+	for (int output = 0; output < outputs; output++)
+	{
+		const signed char* row = weights + output * inputs;
+		__m256i sum = _mm256_setzero_si256();
+		for (int index = 0; index < inputs; index += 32)
+		{
+			__m256i products = _mm256_maddubs_epi16(_mm256_loadu_si256((const __m256i*)(input + index)),
+				_mm256_loadu_si256((const __m256i*)(row + index)));
+			sum = _mm256_add_epi32(sum, _mm256_madd_epi16(products, ones));
+		}
+		__m128i half = _mm_add_epi32(_mm256_castsi256_si128(sum), _mm256_extracti128_si256(sum, 1));
+		half = _mm_add_epi32(half, _mm_shuffle_epi32(half, _MM_SHUFFLE(1, 0, 3, 2)));
+		half = _mm_add_epi32(half, _mm_shuffle_epi32(half, _MM_SHUFFLE(2, 3, 0, 1)));
+		sums[output] = biases[output] + _mm_cvtsi128_si32(half);
+	}
+}
+#endif
+
+static void addWeights(short* values, const short* weights)
+{
+#ifndef NNUE_NO_SIMD
+	if (kernels == AVX2_KERNELS)
+	{
+		addWeightsAvx2(values, weights);
+		return;
+	}
+	if (kernels == SSE41_KERNELS)
+	{
+		addWeightsSse41(values, weights);
+		return;
+	}
+#endif
+	addWeightsScalar(values, weights);
+}
+
+static void subtractWeights(short* values, const short* weights)
+{
+#ifndef NNUE_NO_SIMD
+	if (kernels == AVX2_KERNELS)
+	{
+		subtractWeightsAvx2(values, weights);
+		return;
+	}
+	if (kernels == SSE41_KERNELS)
+	{
+		subtractWeightsSse41(values, weights);
+		return;
+	}
+#endif
+	subtractWeightsScalar(values, weights);
+}
+
+static void transformHalf(const short* values, unsigned char* output)
+{
+#ifndef NNUE_NO_SIMD
+	if (kernels == AVX2_KERNELS)
+	{
+		transformHalfAvx2(values, output);
+		return;
+	}
+	if (kernels == SSE41_KERNELS)
+	{
+		transformHalfSse41(values, output);
+		return;
+	}
+#endif
+	transformHalfScalar(values, output);
+}
+
+static void affineLayer(const unsigned char* input, int inputs, const signed char* weights,
+	const int* biases, int outputs, int* sums)
+{
+#ifndef NNUE_NO_SIMD
+	if (kernels == AVX2_KERNELS)
+	{
+		affineLayerAvx2(input, inputs, weights, biases, outputs, sums);
+		return;
+	}
+	if (kernels == SSE41_KERNELS)
+	{
+		affineLayerSse41(input, inputs, weights, biases, outputs, sums);
+		return;
+	}
+#endif
+	affineLayerScalar(input, inputs, weights, biases, outputs, sums);
+}
+
+// A dense layer's sums scaled down and clipped, as the next layer's inputs
+static void clipLayer(const int* sums, unsigned char* output, int outputs)
+{
+	for (int index = 0; index < outputs; index++)
+	{
+		output[index] = (unsigned char)std::clamp(sums[index] >> WEIGHT_SCALE_BITS, 0, MAX_ACTIVATION);
+	}
+}
+
+#if defined(_MSC_VER) && defined(_M_X64)
+static void cpuid(unsigned leaf, unsigned registers[4])
+{
+	int info[4];
+	__cpuidex(info, (int)leaf, 0);
+	for (int index = 0; index < 4; index++)
+	{
+		registers[index] = (unsigned)info[index];
+	}
+}
+
+static unsigned long long xgetbv()
+{
+	return _xgetbv(0);
+}
+#elif !defined(NNUE_NO_SIMD)
+static void cpuid(unsigned leaf, unsigned registers[4])
+{
+	registers[0] = registers[1] = registers[2] = registers[3] = 0;
+	__get_cpuid_count(leaf, 0, &registers[0], &registers[1], &registers[2], &registers[3]);
+}
+
+static unsigned long long xgetbv()
+{
+	unsigned low, high;
+	__asm__("xgetbv" : "=a"(low), "=d"(high) : "c"(0));
+	return ((unsigned long long)high << 32) | low;
+}
+#endif
+
+/* detectKernels():
+   AVX2 needs the processor to have it and the operating system to save the
+	 256 bit registers (OSXSAVE, then the XMM & YMM bits of XCR0)
+*/
+static Kernels detectKernels()
+{
+#ifdef NNUE_NO_SIMD
+	return SCALAR_KERNELS;
+#else
+	unsigned registers[4];
+	cpuid(0, registers);
+	unsigned maxLeaf = registers[0];
+	if (maxLeaf < 1)
+	{
+		return SCALAR_KERNELS;
+	}
+
+	cpuid(1, registers);
+	bool hasSse41 = (registers[2] & (1u << 19)) != 0;
+	bool hasOsxsave = (registers[2] & (1u << 27)) != 0;
+	if (maxLeaf >= 7 && hasOsxsave && (xgetbv() & 6) == 6)
+	{
+		cpuid(7, registers);
+		if ((registers[1] & (1u << 5)) != 0)
+		{
+			return AVX2_KERNELS;
+		}
+	}
+	return hasSse41 ? SSE41_KERNELS : SCALAR_KERNELS;
+#endif
+}
+
+static struct KernelsInitializer {
+	KernelsInitializer()
+	{
+		kernels = detectKernels();
+	}
+} kernelsInitializer;
+
+const char* networkKernels()
+{
+	static const char* const names[] = { "scalar", "SSE4.1", "AVX2" };
+	return names[kernels];
+}
+
+/* NetworkReader:
+   Little-endian fields of the network file, in order; once a read runs past
+	 the end, isValid() stays false
+*/
+class NetworkReader {
+
+public:
+	NetworkReader(const std::vector<unsigned char>& data) : _data(data), _offset(0), _isValid(true) {}
+
+	unsigned readUnsigned(int bytes)
+	{
+		if (!_isValid || _offset + bytes > _data.size())
+		{
+			_isValid = false;
+			return 0;
+		}
+		unsigned value = 0;
+		for (int index = 0; index < bytes; index++)
+		{
+			value |= (unsigned)_data[_offset + index] << (8 * index);
+		}
+		_offset += bytes;
+		return value;
+	}
+
+	int readInt() { return (int)readUnsigned(4); }
+	short readShort() { return (short)readUnsigned(2); }
+	signed char readChar() { return (signed char)readUnsigned(1); }
+
+	void skip(size_t bytes)
+	{
+		if (_offset + bytes > _data.size())
+		{
+			_isValid = false;
+		}
+		_offset = std::min(_offset + bytes, _data.size());
+	}
+
+	bool isValid() const { return _isValid; }
+	bool isAtEnd() const { return _offset == _data.size(); }
+
+private:
+	const std::vector<unsigned char>& _data;
+	size_t _offset;
+	bool _isValid;
+};
+
+static void readDenseLayer(NetworkReader& reader, int* biases, signed char* weights, int inputs, int outputs)
+{
+	for (int output = 0; output < outputs; output++)
+	{
+		biases[output] = reader.readInt();
+	}
+	for (int index = 0; index < inputs * outputs; index++)
+	{
+		weights[index] = reader.readChar();
+	}
+}
+
+bool loadNetwork(const char* path)
+{
+	std::ifstream file(path, std::ios::binary);
+	if (!file)
+	{
+		return false;
+	}
+	std::vector<unsigned char> data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+	NetworkReader reader(data);
+	if (reader.readUnsigned(4) != NNUE_VERSION)
+	{
+		return false;
+	}
+	reader.readUnsigned(4);
+	reader.skip(reader.readUnsigned(4));
+
+	std::unique_ptr<Network> loaded(new Network);
+	reader.readUnsigned(4);
+	loaded->transformerBiases.resize(NNUE_HALF_DIMENSIONS);
+	for (short& bias : loaded->transformerBiases)
+	{
+		bias = reader.readShort();
+	}
+	loaded->transformerWeights.resize((size_t)NNUE_FEATURES * NNUE_HALF_DIMENSIONS);
+	for (short& weight : loaded->transformerWeights)
+	{
+		weight = reader.readShort();
+	}
+
+	reader.readUnsigned(4);
+	readDenseLayer(reader, loaded->hiddenBiases1, loaded->hiddenWeights1, NNUE_INPUTS, NNUE_HIDDEN);
+	readDenseLayer(reader, loaded->hiddenBiases2, loaded->hiddenWeights2, NNUE_HIDDEN, NNUE_HIDDEN);
+	readDenseLayer(reader, &loaded->outputBias, loaded->outputWeights, NNUE_HIDDEN, 1);
+	if (!reader.isValid() || !reader.isAtEnd())
+	{
+		return false;
+	}
+
+	std::lock_guard<std::mutex> guard(networkLock);
+	loadedNetwork = std::move(loaded);
+	isNetworkOn = true;
+	return true;
+}
+
+void useNetwork(bool isInUse)
+{
+	std::lock_guard<std::mutex> guard(networkLock);
+	isNetworkOn = isInUse;
+}
+
+std::shared_ptr<const Network> currentNetwork()
+{
+	std::lock_guard<std::mutex> guard(networkLock);
+	return isNetworkOn ? loadedNetwork : nullptr;
+}
+
+// The weights of a piece for a side (White 0, Black 1) whose King is on kingSquare
+static const short* featureWeights(const Network* network, int side, int kingSquare, int code, int square)
+{
+	int orientation = side == 0 ? 0 : 63;
+	bool isOwnPiece = isWhitePiece((PieceCode)code) == (side == 0);
+	int feature = (square ^ orientation) + 1 + (typeOf((PieceCode)code) - 1) * 128 + (isOwnPiece ? 0 : 64) +
+		NNUE_PIECE_SQUARES * (kingSquare ^ orientation);
+	return &network->transformerWeights[(size_t)feature * NNUE_HALF_DIMENSIONS];
+}
+
+// A side's accumulator half from scratch: the biases plus the weights of every piece but the Kings
+static void computeHalf(const Position* board, int side, short* values)
+{
+	const Network* network = board->accumulator.network;
+	std::copy(network->transformerBiases.begin(), network->transformerBiases.end(), values);
+	int kingSquare = board->findKing(side == 0);
+	Bitboard pieces = board->occupied() & ~board->byType[KING];
+	while (pieces != EMPTY_BB)
+	{
+		int square = popLsb(pieces);
+		addWeights(values, featureWeights(network, side, kingSquare, board->squares[square], square));
+	}
+}
+
+void refreshAccumulator(Position* board, const Network* network)
+{
+	board->accumulator.network = network;
+	for (int side = 0; side < 2; side++)
+	{
+		board->accumulator.isComputed[side] = network != nullptr && board->findKing(side == 0) != ChessInfo::NO_SQUARE;
+		if (board->accumulator.isComputed[side])
+		{
+			computeHalf(board, side, board->accumulator.values[side]);
+		}
+	}
+}
+
+/* accumulatorPut():
+   Putting down a side's King computes its half afresh (every feature of
+	 that side depends on where its King stands)
+*/
+void accumulatorPut(Position* board, int square, int code)
+{
+	Accumulator& accumulator = board->accumulator;
+	for (int side = 0; side < 2; side++)
+	{
+		if (typeOf((PieceCode)code) == KING)
+		{
+			if (isWhitePiece((PieceCode)code) == (side == 0))
+			{
+				computeHalf(board, side, accumulator.values[side]);
+				accumulator.isComputed[side] = true;
+			}
+		}
+		else if (accumulator.isComputed[side])
+		{
+			addWeights(accumulator.values[side],
+				featureWeights(accumulator.network, side, board->findKing(side == 0), code, square));
+		}
+	}
+}
+
+// Taking a side's King off leaves its half not computed until the King is put down again
+void accumulatorRemove(Position* board, int square, int code)
+{
+	Accumulator& accumulator = board->accumulator;
+	for (int side = 0; side < 2; side++)
+	{
+		if (typeOf((PieceCode)code) == KING)
+		{
+			if (isWhitePiece((PieceCode)code) == (side == 0))
+			{
+				accumulator.isComputed[side] = false;
+			}
+		}
+		else if (accumulator.isComputed[side])
+		{
+			subtractWeights(accumulator.values[side],
+				featureWeights(accumulator.network, side, board->findKing(side == 0), code, square));
+		}
+	}
+}
+
+int evaluateNetwork(const Position* board)
+{
+	const Network* network = board->accumulator.network;
+	alignas(32) short freshValues[NNUE_HALF_DIMENSIONS];
+	alignas(32) unsigned char input[NNUE_INPUTS];
+	int sideToMove = board->isWhiteTurn ? 0 : 1;
+	for (int half = 0; half < 2; half++)
+	{
+		int side = half == 0 ? sideToMove : 1 - sideToMove;
+		const short* values = board->accumulator.values[side];
+		if (!board->accumulator.isComputed[side])
+		{
+			computeHalf(board, side, freshValues);
+			values = freshValues;
+		}
+		transformHalf(values, input + half * NNUE_HALF_DIMENSIONS);
+	}
+
+	int sums[NNUE_HIDDEN];
+	alignas(32) unsigned char hidden1[NNUE_HIDDEN];
+	alignas(32) unsigned char hidden2[NNUE_HIDDEN];
+	affineLayer(input, NNUE_INPUTS, network->hiddenWeights1, network->hiddenBiases1, NNUE_HIDDEN, sums);
+	clipLayer(sums, hidden1, NNUE_HIDDEN);
+	affineLayer(hidden1, NNUE_HIDDEN, network->hiddenWeights2, network->hiddenBiases2, NNUE_HIDDEN, sums);
+	clipLayer(sums, hidden2, NNUE_HIDDEN);
+	affineLayer(hidden2, NNUE_HIDDEN, network->outputWeights, &network->outputBias, 1, sums);
+
+	long long score = (long long)sums[0] * 100 / (NNUE_OUTPUT_SCALE * NNUE_PAWN_VALUE);
+	return (int)std::clamp(score, (long long)-MAX_NETWORK_SCORE, (long long)MAX_NETWORK_SCORE);
+}
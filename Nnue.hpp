@@ -0,0 +1,122 @@
+/* Copyright (C) 2024-2026 Stefan-Mihai MOGA
+This file is part of ChessCtrl application developed by Stefan-Mihai MOGA.
+Fully featured Chess Control written in C++ with the help of the MFC library.
+
+ChessCtrl is free software: you can redistribute it and/or modify it
+under the terms of the GNU General Public License as published by the Open
+Source Initiative, either version 3 of the License, or any later version.
+
+ChessCtrl is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+ChessCtrl. If not, see <http://www.opensource.org/licenses/gpl-3.0.html>*/
+
+
+// Nnue.hpp - Neural network evaluation
+/* An efficiently updatable neural network (NNUE) scoring a position in
+	 place of the material and piece-square evaluation, once a network has
+	 been loaded from a file and while it is in use
+   The network is of the HalfKP 256x2-32-32-1 kind: its inputs are the
+	 (King square, piece, square) features of every piece other than the
+	 Kings, seen from each side with its own King (a Black view is the board
+	 turned round), 64 x 641 of them; the first layer, the feature
+	 transformer, sums the weights of the active features into an
+	 accumulator of NNUE_HALF_DIMENSIONS values per side, the two halves
+	 (the side to move first) go through three small dense layers, clipped
+	 to 0..127 in between, down to the score
+   As a move changes only a few features, Position keeps the accumulator
+	 up to date as it puts and takes off the pieces: the weights of a piece
+	 are added or subtracted, and a side's half is only computed afresh
+	 when its own King moves; the dense layers, in 8 bit integers, are
+	 computed at every evaluation
+   A network is shared: each search holds the network in use when it
+	 starts (currentNetwork()) for as long as it runs, and binds its
+	 positions to it, so that loading another network or switching it off
+	 meanwhile only affects the searches to come
+   The kernels adding the weights and computing the dense layers come in
+	 AVX2, SSE4.1 and plain C++ versions; the choice is made once at
+	 start-up, from what the processor supports (see networkKernels())
+   The file holds, little-endian: the version NNUE_VERSION, a hash and a
+	 description (its length, then the characters); a hash, the transformer
+	 biases (int16 x 256) and weights (int16 x 256 for each feature, the
+	 feature index being square + 641 x King square + 1 + 128 x (piece type
+	 - 1), plus 64 for a rival piece, squares turned round for Black); a
+	 hash, then for each dense layer its biases (int32) and its weights
+	 (int8, by output then input), and nothing more: the layout of the
+	 first HalfKP networks of Stockfish
+*/
+
+#ifndef NNUE_H
+#define NNUE_H
+
+#include <memory>
+
+struct Position;
+struct Network;
+
+static const unsigned NNUE_VERSION = 0x7AF32F16;
+static const int NNUE_PIECE_SQUARES = 641;
+static const int NNUE_FEATURES = 64 * NNUE_PIECE_SQUARES;
+static const int NNUE_HALF_DIMENSIONS = 256;
+static const int NNUE_HIDDEN = 32;
+
+/* The network's output per Pawn: the raw output is divided by
+	 NNUE_OUTPUT_SCALE, in units where a Pawn is worth NNUE_PAWN_VALUE
+*/
+static const int NNUE_OUTPUT_SCALE = 16;
+static const int NNUE_PAWN_VALUE = 208;
+
+// Bound of the network's scores, in centipawns, clear of the mate scores
+static const int MAX_NETWORK_SCORE = 10000;
+
+/* The feature transformer's sums for White (0) and Black (1) under the
+	 network the position is bound to, nullptr for none (the handcrafted
+	 evaluation then), each side's half valid if it is computed
+*/
+struct Accumulator {
+	alignas(32) short values[2][NNUE_HALF_DIMENSIONS];
+	bool isComputed[2];
+	const Network* network;
+};
+
+/* Read the network from the file, return false (the network in use left
+	 as it was) if the file cannot be read or is not a network; a network
+	 loaded is in use until useNetwork(false)
+   N.B.: Both may be called at any time, from any thread: a search running
+		 keeps the network it started with
+*/
+bool loadNetwork(const char* path);
+
+// Switch the network on (if one is loaded) or off
+void useNetwork(bool isInUse);
+
+// The network in use, nullptr if there is none (or it is switched off)
+std::shared_ptr<const Network> currentNetwork();
+
+// "AVX2", "SSE4.1" or "scalar": the kernels in use
+const char* networkKernels();
+
+/* Bind the position to the network and compute its accumulator afresh
+	 for both sides, Position keeping it up to date afterwards; nullptr
+	 unbinds it
+   N.B.: The caller keeps the network alive as long as the position is
+		 bound to it
+*/
+void refreshAccumulator(Position* board, const Network* network);
+
+/* Position.putPiece() / removePiece() of a bound position, once the
+	 bitboards are updated: adds / subtracts the weights of the piece code
+	 on the square
+*/
+void accumulatorPut(Position* board, int square, int code);
+void accumulatorRemove(Position* board, int square, int code);
+
+/* The score of the position for the side to move, in centipawns
+	 (pre-cond.: bound to a network, both Kings on the board); a side whose
+	 half is not computed is computed afresh, without being kept
+*/
+int evaluateNetwork(const Position* board);
+
+#endif
@@ -1,11 +1,10 @@
 // Bryan Liu (chl312), Dept. of Computing, Imperial College London
 // Pawn.cpp - implementation of Pawn extending Piece (info in Pawn.hpp)
 
-#include "pch.h"
 #include "Pawn.hpp"
 
 Pawn::Pawn(bool isWhitePlayer)
-	: Piece(isWhitePlayer)
+	: Piece(isWhitePlayer, PAWN)
 {
 }
 
@@ -13,15 +12,10 @@ Pawn::~Pawn()
 {
 }
 
-Pawn* Pawn::clone()
-{
-	return new Pawn(this->isWhitePlayer());
-}
-
 /* A Pawn has the following valid moves:
    Move vertically (advance in rank in same file):
    Allow to advance 2 ranks if
-	- it is its first move; and
+	- it is its first move (i.e. it still stands on its initial rank); and
 	- there is no obstruction in the intermediate square
    Allow to advance (1 or 2 ranks) if
 	- there is no piece at the destination square
@@ -29,15 +23,18 @@ Pawn* Pawn::clone()
    Capture diagonally:
    Allow move diagonally (and capture) if
 	- destination is 1 rank ahead and in adjacent file; and
-	- (existing) piece in destination belongs to the rivalry
+	- (existing) piece in destination belongs to the rivalry, or the
+	  destination is the en passant square the rivalry's Pawn just skipped
+
+   Reaching the last rank promotes the Pawn (see Position::makeMove)
 
    Pawn.isValidMove() post-cond: retrun 0 if move is valid as above
 								 respective error code otherwise
 */
-int Pawn::isValidMove(wstring sourceFileRank, wstring destFileRank, map<wstring, Piece*>* board)
+int Pawn::isValidMove(int sourceSquare, int destSquare, const Position* board)
 {
-	if (isSameFile(sourceFileRank, destFileRank) &&
-		isSameRank(sourceFileRank, destFileRank))
+	if (isSameFile(sourceSquare, destSquare) &&
+		isSameRank(sourceSquare, destSquare))
 	{
 		return ChessErrHandler::DEST_EQ_SOURCE;
 	}
@@ -45,22 +42,22 @@ int Pawn::isValidMove(wstring sourceFileRank, wstring destFileRank, map<wstring,
 	/* Pawn is only allowed to move "forward"
 	   with calculations depending on which side it belongs
 	*/
-	TCHAR destRank = destFileRank.at(ChessInfo::RANK_INDEX);
-	TCHAR sourceRank = sourceFileRank.at(ChessInfo::RANK_INDEX);
-	int rankAdvancement =
-		_isWhitePlayer ? destRank - sourceRank : sourceRank - destRank;
+	int rankAdvancement = _isWhitePlayer ?
+		rankOf(destSquare) - rankOf(sourceSquare) :
+		rankOf(sourceSquare) - rankOf(destSquare);
+	Piece* destPiece = board->pieceAt(destSquare);
 
-	if (isSameFile(sourceFileRank, destFileRank))
+	if (isSameFile(sourceSquare, destSquare))
 	{
 		switch (rankAdvancement)
 		{
 			case 2:
 			{
-				if (!isFirstMove)
+				if (!isOnInitialRank(sourceSquare))
 				{
 					return ChessErrHandler::ILLEGAL_MOVE_PATTERN;
 				}
-				if (!noVerticalObstruction(sourceFileRank, destFileRank, board))
+				if (!noVerticalObstruction(sourceSquare, destSquare, board))
 				{
 					return ChessErrHandler::OBSTRUCTION_EN_ROUTE;
 				}
@@ -71,13 +68,13 @@ int Pawn::isValidMove(wstring sourceFileRank, wstring destFileRank, map<wstring,
 			default: return ChessErrHandler::ILLEGAL_MOVE_PATTERN;
 		}
 
-		try
+		/* A piece occupying the destination is undesirable regardless of
+		   its friendliness
+		   The if clause is simply to check which error number to return
+		*/
+		if (destPiece != nullptr)
 		{
-			/* If no exception is thrown, a piece is occupying the destination
-			   Which is undesirable regardless of its friendliness
-			   The if clause is simply to check which error number to return
-			*/
-			if (isFriendly(board->at(destFileRank)))
+			if (isFriendly(destPiece))
 			{
 				return ChessErrHandler::FRIENDLY_AT_DEST;
 			}
@@ -85,27 +82,15 @@ int Pawn::isValidMove(wstring sourceFileRank, wstring destFileRank, map<wstring,
 				return ChessErrHandler::PAWN_ILLEGAL_CAPTURE_PATTERN;
 			}
 		}
-		catch (const std::out_of_range& err) {
-			UNREFERENCED_PARAMETER(err);
-			// No piece at destination, expected to return CHESS_NO_ERROR
-		}
-
 	}
 	else
 	{
-		try
+		// Pawn cannot move diagonally if it is not capturing a rivalry piece
+		bool isCapture = (destPiece != nullptr && !isFriendly(destPiece)) ||
+			isEnPassantCapture(destSquare, board);
+		if (!(rankAdvancement == 1 &&
+			isAdjacentFile(sourceSquare, destSquare) && isCapture))
 		{
-			if (!(rankAdvancement == 1 &&
-				isAdjacentFile(sourceFileRank, destFileRank) &&
-				!isFriendly(board->at(destFileRank))))
-			{
-				return ChessErrHandler::ILLEGAL_MOVE_PATTERN;
-			}
-		}
-		catch (const std::out_of_range& err)
-		{
-			UNREFERENCED_PARAMETER(err);
-			// Pawn cannot move diagonally if it is not capturing a rivalry piece
 			return ChessErrHandler::ILLEGAL_MOVE_PATTERN;
 		}
 	}
@@ -136,14 +121,39 @@ wstring Pawn::toGraphics()
    pre-cond: args are valid file & rank representations of a different square
    post-cond: return true if absolute file difference of args is 1
 */
-bool Pawn::isAdjacentFile(wstring sourceFileRank, wstring destFileRank)
+bool Pawn::isAdjacentFile(int sourceSquare, int destSquare)
 {
-	TCHAR sourceFile = sourceFileRank.at(ChessInfo::FILE_INDEX);
-	TCHAR destFile = destFileRank.at(ChessInfo::FILE_INDEX);
-	return abs(destFile - sourceFile) == 1;
+	return abs(fileOf(destSquare) - fileOf(sourceSquare)) == 1;
+}
+
+/* Pawn.isEnPassantCapture():
+   post-cond: return true if destSquare is the en passant square left by a
+			  rivalry Pawn (i.e. on the rank this Pawn would capture it from)
+*/
+bool Pawn::isEnPassantCapture(int destSquare, const Position* board)
+{
+	int epRank = _isWhitePlayer ? ChessInfo::NUM_RANKS - 3 : 2;
+	return destSquare == board->epSquare && rankOf(destSquare) == epRank;
+}
+
+/* Pawn.isOnInitialRank():
+   pre-cond: sourceSquare is a valid square
+   post-cond: return true if the square is on this side's initial pawn rank,
+			  which a Pawn can only occupy before its first move
+*/
+bool Pawn::isOnInitialRank(int sourceSquare)
+{
+	TCHAR initialRank = _isWhitePlayer ?
+		ChessInfo::WHITE_INIT_PAWN_RANK : ChessInfo::BLACK_INIT_PAWN_RANK;
+	return rankOf(sourceSquare) == initialRank - ChessInfo::MIN_RANK;
 }
 
 int Pawn::Score()
 {
-	return 1;
+	return 100;
+}
+
+int Pawn::EndgameScore()
+{
+	return 130;
 }
@@ -2,15 +2,15 @@
 // Pawn.hpp - Pawn extending Piece
 
 /* Represent Implementation of a Pawn piece in chess
-   Including concrete implementation of clone(), isValidMove(), toString()
+   Including concrete implementation of isValidMove(), toString()
 	 and toGraphics(), inherited from abstract superclass Piece
-   Private method isAdjacentFile() used in logic of validing move of a Pawn
+   Private methods isAdjacentFile(), isEnPassantCapture() and
+	 isOnInitialRank() used in logic of validing move of a Pawn
 */
 
 #ifndef PAWN_H
 #define PAWN_H
 
-#include <map>
 #include <string>
 
 #include "Piece.hpp"
@@ -20,16 +20,18 @@ class Pawn : public Piece {
 public:
 	Pawn(bool isWhitePlayer);
 	~Pawn();
-	Pawn* clone();
 
-	int isValidMove(wstring sourceFileRank, wstring destFileRank, map<wstring, Piece*>* board);
+	int isValidMove(int sourceSquare, int destSquare, const Position* board);
 	wstring toString();
 	wstring toGraphics();
 
 private:
-	bool isAdjacentFile(wstring sourceFileRank, wstring destFileRank);
+	bool isAdjacentFile(int sourceSquare, int destSquare);
+	bool isEnPassantCapture(int destSquare, const Position* board);
+	bool isOnInitialRank(int sourceSquare);
 public:
 	int Score(); // Stefan-Mihai Moga
+	int EndgameScore();
 };
 
 #endif
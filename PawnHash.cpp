@@ -0,0 +1,53 @@
+/* Copyright (C) 2024-2026 Stefan-Mihai MOGA
+This file is part of ChessCtrl application developed by Stefan-Mihai MOGA.
+Fully featured Chess Control written in C++ with the help of the MFC library.
+
+ChessCtrl is free software: you can redistribute it and/or modify it
+under the terms of the GNU General Public License as published by the Open
+Source Initiative, either version 3 of the License, or any later version.
+
+ChessCtrl is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+ChessCtrl. If not, see <http://www.opensource.org/licenses/gpl-3.0.html>*/
+
+// PawnHash.cpp - Implementation of PawnHash (info in PawnHash.hpp)
+
+#include "PawnHash.hpp"
+
+// The entry count is rounded down to a power of two, indexed by the low bits of the key
+PawnHash::PawnHash(int entries)
+{
+	size_t entryCount = 1;
+	while ((int)entryCount * 2 <= entries)
+	{
+		entryCount *= 2;
+	}
+	_entries.reset(new PawnEntry[entryCount]);
+	_mask = entryCount - 1;
+	clear();
+}
+
+PawnEntry* PawnHash::probe(Key pawnKey)
+{
+	PawnEntry* entry = &_entries[pawnKey & _mask];
+	_probes++;
+	if (entry->key == pawnKey)
+	{
+		_hits++;
+	}
+	return entry;
+}
+
+void PawnHash::clear()
+{
+	for (Key index = 0; index <= _mask; index++)
+	{
+		_entries[index] = PawnEntry();
+		_entries[index].key = ~index;
+	}
+	_probes = 0;
+	_hits = 0;
+}
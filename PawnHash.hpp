@@ -0,0 +1,73 @@
+/* Copyright (C) 2024-2026 Stefan-Mihai MOGA
+This file is part of ChessCtrl application developed by Stefan-Mihai MOGA.
+Fully featured Chess Control written in C++ with the help of the MFC library.
+
+ChessCtrl is free software: you can redistribute it and/or modify it
+under the terms of the GNU General Public License as published by the Open
+Source Initiative, either version 3 of the License, or any later version.
+
+ChessCtrl is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+ChessCtrl. If not, see <http://www.opensource.org/licenses/gpl-3.0.html>*/
+
+// PawnHash.hpp - Pawn hash table
+/* The Pawn structure terms of the evaluation (doubled, isolated, backward
+	 and passed Pawns, the shelter in front of each King) depend on the
+	 Pawns alone, which move far less often than the other pieces: the same
+	 Pawn skeleton is met again and again in a search
+   A PawnHash remembers the terms of each skeleton by its pawn key (the
+	 Zobrist key of the Pawns alone, kept by Position), so that they are
+	 computed once per skeleton; it belongs to one search thread, no lock
+	 is needed, and it counts its probes and hits to tell how well it works
+*/
+
+#ifndef PAWNHASH_H
+#define PAWNHASH_H
+
+#include <memory>
+
+#include "Zobrist.hpp"
+
+static const int DEFAULT_PAWN_HASH_ENTRIES = 16384;
+
+/* Pawn structure terms of a skeleton, in centipawns from White's point of
+	 view: the middlegame and endgame scores, and for each side (White 0,
+	 Black 1) the shelter its Pawns give a King on the Queen side (files A
+	 to C), in the centre (D and E) or on the King side (F to H)
+*/
+struct PawnEntry {
+	Key key;
+	short middlegame;
+	short endgame;
+	signed char shelter[2][3];
+};
+
+class PawnHash {
+
+public:
+	PawnHash(int entries = DEFAULT_PAWN_HASH_ENTRIES);
+
+	/* The entry for the pawn key: a hit if its key is pawnKey, otherwise the
+		 caller fills it in
+	   N.B.: An empty entry holds a key which does not lead to its own slot,
+			 so that no pawn key (not even the zero key of a board without
+			 Pawns) is taken for a hit on it
+	*/
+	PawnEntry* probe(Key pawnKey);
+
+	void clear();
+
+	unsigned long long probes() const { return _probes; }
+	unsigned long long hits() const { return _hits; }
+
+private:
+	std::unique_ptr<PawnEntry[]> _entries;
+	Key _mask;
+	unsigned long long _probes;
+	unsigned long long _hits;
+};
+
+#endif
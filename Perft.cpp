@@ -0,0 +1,163 @@
+/* Copyright (C) 2024-2026 Stefan-Mihai MOGA
+This file is part of ChessCtrl application developed by Stefan-Mihai MOGA.
+Fully featured Chess Control written in C++ with the help of the MFC library.
+
+ChessCtrl is free software: you can redistribute it and/or modify it
+under the terms of the GNU General Public License as published by the Open
+Source Initiative, either version 3 of the License, or any later version.
+
+ChessCtrl is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+ChessCtrl. If not, see <http://www.opensource.org/licenses/gpl-3.0.html>*/
+
+// Perft.cpp - Implementation of Perft (info in Perft.hpp)
+
+#include "Perft.hpp"
+#include <thread>
+#include <vector>
+
+/* The start position, the positions of the chessprogramming wiki "Perft
+	 Results" page, and positions collected on the TalkChess forum for the
+	 bugs move generators usually have (en passant discovering a check,
+	 castling giving check, promotions under pins...)
+*/
+const PerftCase perftSuite[] = {
+	{ "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1", 5, 4865609ULL },
+	{ "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1", 4, 4085603ULL },
+	{ "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1", 6, 11030083ULL },
+	{ "r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1", 4, 422333ULL },
+	{ "r2q1rk1/pP1p2pp/Q4n2/bbp1p3/Np6/1B3NBn/pPPP1PPP/R3K2R b KQ - 0 1", 4, 422333ULL },
+	{ "rnbq1k1r/pp1Pbppp/2p5/8/2B5/8/PPP1NnPP/RNBQK2R w KQ - 1 8", 4, 2103487ULL },
+	{ "r4rk1/1pp1qppp/p1np1n2/2b1p1B1/2B1P1b1/P1NP1N2/1PP1QPPP/R4RK1 w - - 0 10", 4, 3894594ULL },
+	{ "3k4/3p4/8/K1P4r/8/8/8/8 b - - 0 1", 6, 1134888ULL },
+	{ "8/8/4k3/8/2p5/8/B2P2K1/8 w - - 0 1", 6, 1015133ULL },
+	{ "8/8/1k6/2b5/2pP4/8/5K2/8 b - d3 0 1", 6, 1440467ULL },
+	{ "5k2/8/8/8/8/8/8/4K2R w K - 0 1", 6, 661072ULL },
+	{ "3k4/8/8/8/8/8/8/R3K3 w Q - 0 1", 6, 803711ULL },
+	{ "r3k2r/1b4bq/8/8/8/8/7B/R3K2R w KQkq - 0 1", 4, 1274206ULL },
+	{ "r3k2r/8/3Q4/8/8/5q2/8/R3K2R b KQkq - 0 1", 4, 1720476ULL },
+	{ "2K2r2/4P3/8/8/8/8/8/3k4 w - - 0 1", 6, 3821001ULL },
+	{ "8/8/1P2K3/8/2n5/1q6/8/5k2 b - - 0 1", 5, 1004658ULL },
+	{ "4k3/1P6/8/8/8/8/K7/8 w - - 0 1", 6, 217342ULL },
+	{ "8/P1k5/K7/8/8/8/8/8 w - - 0 1", 6, 92683ULL },
+	{ "K1k5/8/P7/8/8/8/8/8 w - - 0 1", 6, 2217ULL },
+	{ "8/k1P5/8/1K6/8/8/8/8 w - - 0 1", 7, 567584ULL },
+	{ "8/8/2k5/5q2/5n2/8/5K2/8 b - - 0 1", 4, 23527ULL }
+};
+
+const int PERFT_SUITE_SIZE = sizeof(perftSuite) / sizeof(perftSuite[0]);
+
+// The same position at another depth is another entry
+static Key perftKey(Key key, int depth)
+{
+	return key ^ ((Key)depth * 0x9E3779B97F4A7C15ULL);
+}
+
+PerftHash::PerftHash(int megabytes)
+{
+	size_t slotCount = 1;
+	size_t maxSlots = ((size_t)(megabytes > 0 ? megabytes : 0) << 20) / sizeof(Slot);
+	while (slotCount * 2 <= maxSlots)
+	{
+		slotCount *= 2;
+	}
+	_slots.reset(new Slot[slotCount]);
+	_mask = slotCount - 1;
+	for (size_t index = 0; index < slotCount; index++)
+	{
+		_slots[index].keyXorNodes.store(0, std::memory_order_relaxed);
+		_slots[index].nodes.store(0, std::memory_order_relaxed);
+	}
+}
+
+bool PerftHash::probe(Key key, int depth, unsigned long long& nodes) const
+{
+	Key slotKey = perftKey(key, depth);
+	const Slot& slot = _slots[slotKey & _mask];
+	unsigned long long slotNodes = slot.nodes.load(std::memory_order_relaxed);
+	if ((slot.keyXorNodes.load(std::memory_order_relaxed) ^ slotNodes) != slotKey || slotNodes == 0)
+	{
+		return false;
+	}
+	nodes = slotNodes;
+	return true;
+}
+
+// Always replace: the latest subtrees are the likeliest to come again
+void PerftHash::store(Key key, int depth, unsigned long long nodes)
+{
+	Key slotKey = perftKey(key, depth);
+	Slot& slot = _slots[slotKey & _mask];
+	slot.keyXorNodes.store(slotKey ^ nodes, std::memory_order_relaxed);
+	slot.nodes.store(nodes, std::memory_order_relaxed);
+}
+
+unsigned long long perft(Position* board, int depth, PerftHash* hash)
+{
+	if (depth <= 0)
+	{
+		return 1;
+	}
+
+	unsigned long long nodes = 0;
+	if (depth > 1 && hash != nullptr && hash->probe(board->key, depth, nodes))
+	{
+		return nodes;
+	}
+
+	Move moves[MAX_MOVES];
+	int count = generateLegalMoves(board, moves);
+	if (depth == 1)
+	{
+		return count;
+	}
+
+	for (int index = 0; index < count; index++)
+	{
+		UndoRecord undo;
+		board->makeMove(moves[index], undo);
+		nodes += perft(board, depth - 1, hash);
+		board->unmakeMove(moves[index], undo);
+	}
+
+	if (hash != nullptr)
+	{
+		hash->store(board->key, depth, nodes);
+	}
+	return nodes;
+}
+
+/* perftDivide():
+   Each thread takes the next root move not taken yet until there are none
+	 left, so a thread done with a small subtree goes on with another one
+*/
+int perftDivide(Position* board, int depth, Move* moves, unsigned long long* counts,
+	int threads, PerftHash* hash)
+{
+	int count = generateLegalMoves(board, moves);
+	std::atomic<int> nextMove(0);
+	auto countRootMoves = [&](Position position) {
+		for (int index = nextMove++; index < count; index = nextMove++)
+		{
+			UndoRecord undo;
+			position.makeMove(moves[index], undo);
+			counts[index] = perft(&position, depth - 1, hash);
+			position.unmakeMove(moves[index], undo);
+		}
+	};
+
+	std::vector<std::thread> helpers;
+	for (int helper = 1; helper < threads && helper < count; helper++)
+	{
+		helpers.emplace_back(countRootMoves, *board);
+	}
+	countRootMoves(*board);
+	for (std::thread& helper : helpers)
+	{
+		helper.join();
+	}
+	return count;
+}
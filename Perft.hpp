@@ -0,0 +1,81 @@
+/* Copyright (C) 2024-2026 Stefan-Mihai MOGA
+This file is part of ChessCtrl application developed by Stefan-Mihai MOGA.
+Fully featured Chess Control written in C++ with the help of the MFC library.
+
+ChessCtrl is free software: you can redistribute it and/or modify it
+under the terms of the GNU General Public License as published by the Open
+Source Initiative, either version 3 of the License, or any later version.
+
+ChessCtrl is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+ChessCtrl. If not, see <http://www.opensource.org/licenses/gpl-3.0.html>*/
+
+// Perft.hpp - Perft
+/* Performance test of the move generator: count the leaf nodes of the
+	 tree of legal moves to a fixed depth and compare them with the counts
+	 published for reference positions; any difference means a move is
+	 missing, extra or played wrong somewhere in the tree
+   The count also measures the speed of move generation (nodes per second)
+	 with make/unmake included; at the last ply the legal moves are counted
+	 without being played
+   For large depths the root moves can be shared out between threads, and
+	 the count of each subtree remembered in a PerftHash (keyed by the
+	 Zobrist key and the depth) so that a transposition is counted once
+*/
+
+#ifndef PERFT_H
+#define PERFT_H
+
+#include <atomic>
+#include <memory>
+
+#include "MoveGen.hpp"
+
+/* Subtree counts by position & depth, shared by the perft threads without
+	 any lock: a slot holds the count and the key xored with the count, a
+	 slot torn by two threads writing at once no longer matches its key
+*/
+class PerftHash {
+
+public:
+	PerftHash(int megabytes);
+
+	bool probe(Key key, int depth, unsigned long long& nodes) const;
+	void store(Key key, int depth, unsigned long long nodes);
+
+private:
+	struct Slot {
+		std::atomic<unsigned long long> keyXorNodes;
+		std::atomic<unsigned long long> nodes;
+	};
+
+	std::unique_ptr<Slot[]> _slots;
+	Key _mask;
+};
+
+// Leaf nodes of the tree of legal moves depth plies deep, board is restored
+unsigned long long perft(Position* board, int depth, PerftHash* hash = nullptr);
+
+/* The same count broken down by root move: moves receives the legal root
+	 moves and counts the leaf nodes under each of them (both with room for
+	 MAX_MOVES entries); return the number of root moves
+   The root moves are shared out between the given number of threads, each
+	 with its own copy of the position
+*/
+int perftDivide(Position* board, int depth, Move* moves, unsigned long long* counts,
+	int threads = 1, PerftHash* hash = nullptr);
+
+struct PerftCase {
+	const char* fen;
+	int depth;
+	unsigned long long nodes;
+};
+
+// Reference positions with their published counts
+extern const PerftCase perftSuite[];
+extern const int PERFT_SUITE_SIZE;
+
+#endif
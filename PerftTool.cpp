@@ -0,0 +1,154 @@
+/* Copyright (C) 2024-2026 Stefan-Mihai MOGA
+This file is part of ChessCtrl application developed by Stefan-Mihai MOGA.
+Fully featured Chess Control written in C++ with the help of the MFC library.
+
+ChessCtrl is free software: you can redistribute it and/or modify it
+under the terms of the GNU General Public License as published by the Open
+Source Initiative, either version 3 of the License, or any later version.
+
+ChessCtrl is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+ChessCtrl. If not, see <http://www.opensource.org/licenses/gpl-3.0.html>*/
+
+/* PerftTool.cpp - Headless perft command, utilising the Perft library
+   Usage:
+   - PerftTool perft [options] <depth> [FEN]: leaf nodes to the depth (from
+	 the start position if no FEN is given), with the time taken and nodes
+	 per second
+   - PerftTool divide [options] <depth> [FEN]: the same, broken down by
+	 root move
+   - PerftTool suite [options]: the regression table of reference positions,
+	 the exit code is the number of positions whose count is wrong
+   Options:
+   - -t <threads>: threads sharing out the root moves (default: one per
+	 hardware thread)
+   - -h <MB>: size of the hash table of subtree counts (default: 0, none)
+*/
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+
+using namespace std;
+
+#include "Perft.hpp"
+
+static double secondsSince(chrono::steady_clock::time_point start)
+{
+	return chrono::duration<double>(chrono::steady_clock::now() - start).count();
+}
+
+static void printSpeed(unsigned long long nodes, double seconds)
+{
+	cout << "Nodes: " << nodes << "  Time: " << (int)(seconds * 1000) << " ms  NPS: "
+		<< (unsigned long long)(seconds > 0 ? nodes / seconds : 0) << endl;
+}
+
+// Count from the position on the given threads, root move by root move
+static unsigned long long countNodes(Position* board, int depth, int threads, PerftHash* hash,
+	bool showDivide)
+{
+	Move moves[MAX_MOVES];
+	unsigned long long counts[MAX_MOVES];
+	int count = perftDivide(board, depth, moves, counts, threads, hash);
+	unsigned long long nodes = 0;
+	for (int index = 0; index < count; index++)
+	{
+		if (showDivide)
+		{
+			cout << moveToString(moves[index]) << ": " << counts[index] << endl;
+		}
+		nodes += counts[index];
+	}
+	if (showDivide)
+	{
+		cout << "Moves: " << count << endl;
+	}
+	return depth > 0 ? nodes : 1;
+}
+
+static int runSuite(int threads, PerftHash* hash)
+{
+	int failures = 0;
+	unsigned long long totalNodes = 0;
+	auto start = chrono::steady_clock::now();
+	for (int index = 0; index < PERFT_SUITE_SIZE; index++)
+	{
+		const PerftCase& test = perftSuite[index];
+		Position board;
+		board.loadFEN(test.fen);
+		auto caseStart = chrono::steady_clock::now();
+		unsigned long long nodes = countNodes(&board, test.depth, threads, hash, false);
+		double seconds = secondsSince(caseStart);
+		totalNodes += nodes;
+		bool isRight = nodes == test.nodes;
+		failures += isRight ? 0 : 1;
+		cout << (isRight ? "OK    " : "FAIL  ") << test.fen << "  depth " << test.depth
+			<< ": " << nodes << (isRight ? "" : " expected " + to_string(test.nodes))
+			<< "  (" << (int)(seconds * 1000) << " ms)" << endl;
+	}
+	printSpeed(totalNodes, secondsSince(start));
+	cout << (PERFT_SUITE_SIZE - failures) << "/" << PERFT_SUITE_SIZE << " positions right" << endl;
+	return failures;
+}
+
+int main(int argc, char* argv[])
+{
+	string command = argc > 1 ? argv[1] : "";
+	int threads = (int)thread::hardware_concurrency();
+	int hashSize = 0;
+	int depth = -1;
+	string fen;
+	for (int index = 2; index < argc; index++)
+	{
+		string argument = argv[index];
+		if (argument == "-t" && index + 1 < argc)
+		{
+			threads = atoi(argv[++index]);
+		}
+		else if (argument == "-h" && index + 1 < argc)
+		{
+			hashSize = atoi(argv[++index]);
+		}
+		else if (depth < 0)
+		{
+			depth = atoi(argv[index]);
+		}
+		else
+		{
+			fen += (fen.empty() ? "" : " ") + argument;
+		}
+	}
+
+	unique_ptr<PerftHash> hash(hashSize > 0 ? new PerftHash(hashSize) : nullptr);
+	cout << "Threads: " << max(threads, 1) << "  Hash: " << hashSize << " MB" << endl;
+	if (command == "suite")
+	{
+		return runSuite(threads, hash.get());
+	}
+	if ((command != "perft" && command != "divide") || depth < 0)
+	{
+		cerr << "Usage: PerftTool perft|divide [-t threads] [-h MB] <depth> [FEN]"
+			<< " | PerftTool suite [-t threads] [-h MB]" << endl;
+		return EXIT_FAILURE;
+	}
+
+	Position board;
+	if (!board.loadFEN(fen.empty() ? START_FEN : fen.c_str()))
+	{
+		cerr << "Invalid FEN: " << fen << endl;
+		return EXIT_FAILURE;
+	}
+
+	auto start = chrono::steady_clock::now();
+	unsigned long long nodes = countNodes(&board, depth, threads, hash.get(), command == "divide");
+	printSpeed(nodes, secondsSince(start));
+	return EXIT_SUCCESS;
+}
@@ -3,24 +3,43 @@
    (Constructor, Deconstructor and common methods for extending classes)
 */
 
-#include "pch.h"
 #include "Piece.hpp"
-
-Piece::Piece(bool isWhitePlayer)
+#include "King.hpp"
+#include "Queen.hpp"
+#include "Bishop.hpp"
+#include "Rook.hpp"
+#include "Knight.hpp"
+#include "Pawn.hpp"
+
+Piece::Piece(bool isWhitePlayer, PieceType type)
 {
 	_isWhitePlayer = isWhitePlayer;
+	_type = type;
 }
 
 Piece::~Piece()
 {
 }
 
-/* Piece.confirmMove():
-   set isFirstMove false when called as it has moved at least once
+/* Piece.fromCode():
+   One instance per piece type and player is enough, as a Piece only knows
+	 its owner and how it moves; the board keeps everything else
 */
-void Piece::confirmMove()
+Piece* Piece::fromCode(PieceCode code)
 {
-	isFirstMove = false;
+	static Pawn whitePawn(true), blackPawn(false);
+	static Knight whiteKnight(true), blackKnight(false);
+	static Bishop whiteBishop(true), blackBishop(false);
+	static Rook whiteRook(true), blackRook(false);
+	static Queen whiteQueen(true), blackQueen(false);
+	static King whiteKing(true), blackKing(false);
+
+	static Piece* const pieces[2][KING + 1] = {
+		{ nullptr, &whitePawn, &whiteKnight, &whiteBishop, &whiteRook, &whiteQueen, &whiteKing },
+		{ nullptr, &blackPawn, &blackKnight, &blackBishop, &blackRook, &blackQueen, &blackKing }
+	};
+
+	return pieces[isWhitePiece(code) ? 0 : 1][typeOf(code)];
 }
 
 // Piece.isWhitePlayer() post-cond.: return if this piece belongs to White p.
@@ -29,12 +48,21 @@ bool Piece::isWhitePlayer()
 	return (_isWhitePlayer);
 }
 
-/* Piece.isKing() post-cond.: return true if the piece is a King
-	 (represented by _isKing - only set to true by King constructor)
-*/
+// Piece.isKing() post-cond.: return true if the piece is a King
 bool Piece::isKing()
 {
-	return _isKing;
+	return _type == KING;
+}
+
+PieceType Piece::type()
+{
+	return _type;
+}
+
+// Piece.code() post-cond.: return the code standing for this piece on a board
+PieceCode Piece::code()
+{
+	return makePieceCode(_type, _isWhitePlayer);
 }
 
 /* Piece.isFriendly()
@@ -53,164 +81,67 @@ wstring Piece::playerToString()
 }
 
 /* Piece::isSame_ ()
-   Pre-cond.: sourceFileRank, destFileRank valid file & rank representation
-   Post-cond.: return true if sourceFileRank and destFileRank is on the same
+   Pre-cond.: sourceSquare, destSquare valid squares
+   Post-cond.: return true if sourceSquare and destSquare is on the same
 			   file/ rank/ diagonal respectively
 */
-bool Piece::isSameFile(wstring sourceFileRank, wstring destFileRank)
+bool Piece::isSameFile(int sourceSquare, int destSquare)
 {
-	return sourceFileRank.at(ChessInfo::FILE_INDEX) ==
-		destFileRank.at(ChessInfo::FILE_INDEX);
+	return fileOf(sourceSquare) == fileOf(destSquare);
 }
 
-bool Piece::isSameRank(wstring sourceFileRank, wstring destFileRank)
+bool Piece::isSameRank(int sourceSquare, int destSquare)
 {
-	return sourceFileRank.at(ChessInfo::RANK_INDEX) ==
-		destFileRank.at(ChessInfo::RANK_INDEX);
+	return rankOf(sourceSquare) == rankOf(destSquare);
 
 }
 
-bool Piece::isSameDiagonal(wstring sourceFileRank, wstring destFileRank)
+bool Piece::isSameDiagonal(int sourceSquare, int destSquare)
 {
-	return abs(sourceFileRank.at(ChessInfo::FILE_INDEX) -
-		destFileRank.at(ChessInfo::FILE_INDEX)) ==
-		abs(sourceFileRank.at(ChessInfo::RANK_INDEX) -
-			destFileRank.at(ChessInfo::RANK_INDEX));
+	return abs(fileOf(sourceSquare) - fileOf(destSquare)) ==
+		abs(rankOf(sourceSquare) - rankOf(destSquare));
 }
 
 /* Piece.noVerticalObstruction()
-   Pre-cond.: sourceFileRank, destFileRank valid file & rank representation
-			  board a valid, existing reference to map rep. of the board
+   Pre-cond.: sourceSquare, destSquare valid squares on the same file
+			  board a valid, existing reference to the Position
    Post-cond.: return true if there are no pieces on intermediate ranks
 			   on the board
 */
-bool Piece::noVerticalObstruction(wstring sourceFileRank, wstring destFileRank, map<wstring, Piece*>* board)
-{
-
-	TCHAR sourceFile = sourceFileRank.at(ChessInfo::FILE_INDEX);
-	TCHAR sourceRank = sourceFileRank.at(ChessInfo::RANK_INDEX);
-	TCHAR destRank = destFileRank.at(ChessInfo::RANK_INDEX);
-	TCHAR lowRank = (sourceRank < destRank) ? sourceRank : destRank;
-	TCHAR highRank = (sourceRank < destRank) ? destRank : sourceRank;
-
-	for (TCHAR i = lowRank + ChessInfo::EXCLUSIVE_SHIFT; i < highRank; i++)
-	{
-		wstring between({ sourceFile, i });
-		try
-		{
-			auto temp = board->at(between);
-			UNREFERENCED_PARAMETER(temp);
-			return false;
-		}
-		catch (const std::out_of_range& err)
-		{
-			UNREFERENCED_PARAMETER(err);
-			// No piece for this file & rank, no action required
-		}
-	}
-	return true;
+bool Piece::noVerticalObstruction(int sourceSquare, int destSquare, const Position* board)
+{
+	return (betweenSquares(sourceSquare, destSquare) & board->occupied()) == EMPTY_BB;
 }
-
-/* Piece.noVerticalObstruction()
-   Pre-cond.: sourceFileRank, destFileRank valid file & rank representation
-			  board a valid, existing reference to map rep. of the board
+/* Piece.noHorizontalObstruction()
+   Pre-cond.: sourceSquare, destSquare valid squares on the same rank
+			  board a valid, existing reference to the Position
    Post-cond.: return true if there are no pieces on intermediate files
 			   on the board
 */
-bool Piece::noHorizontalObstruction(wstring sourceFileRank, wstring destFileRank, map<wstring, Piece*>* board)
-{
-
-	TCHAR sourceFile = sourceFileRank.at(ChessInfo::FILE_INDEX);
-	TCHAR sourceRank = sourceFileRank.at(ChessInfo::RANK_INDEX);
-	TCHAR destFile = destFileRank.at(ChessInfo::FILE_INDEX);
-	TCHAR lowFile = (sourceFile < destFile) ? sourceFile : destFile;
-	TCHAR highFile = (sourceFile < destFile) ? destFile : sourceFile;
-
-	for (TCHAR i = lowFile + ChessInfo::EXCLUSIVE_SHIFT; i < highFile; i++)
-	{
-		wstring between({ i, sourceRank });
-		try
-		{
-			auto temp = board->at(between);
-			UNREFERENCED_PARAMETER(temp);
-			return false;
-		}
-		catch (const std::out_of_range& err)
-		{
-			UNREFERENCED_PARAMETER(err);
-			// No piece for this file & rank, no action required
-		}
-	}
-	return true;
+bool Piece::noHorizontalObstruction(int sourceSquare, int destSquare, const Position* board)
+{
+	return (betweenSquares(sourceSquare, destSquare) & board->occupied()) == EMPTY_BB;
 }
-
-/* Piece.noVerticalObstruction()
-   Pre-cond.: sourceFileRank, destFileRank valid file & rank representation
-			  board a valid, existing reference to map rep. of the board
+/* Piece.noDiagonalObstruction()
+   Pre-cond.: sourceSquare, destSquare valid squares on the same diagonal
+			  board a valid, existing reference to the Position
    Post-cond.: return true if there are no pieces on intermediate files
 			   and ranks, which is on the same diagonal, on the board
 */
-bool Piece::noDiagonalObstruction(wstring sourceFileRank, wstring destFileRank, map<wstring, Piece*>* board)
-{
-
-	TCHAR sourceFile = sourceFileRank.at(ChessInfo::FILE_INDEX);
-	TCHAR destFile = destFileRank.at(ChessInfo::FILE_INDEX);
-	TCHAR lowFile = (sourceFile < destFile) ? sourceFile : destFile;
-	TCHAR highFile = (sourceFile < destFile) ? destFile : sourceFile;
-
-	TCHAR sourceRank = sourceFileRank.at(ChessInfo::RANK_INDEX);
-	TCHAR destRank = destFileRank.at(ChessInfo::RANK_INDEX);
-	TCHAR lowRank = (sourceRank < destRank) ? sourceRank : destRank;
-	TCHAR highRank = (sourceRank < destRank) ? destRank : sourceRank;
-
-	bool isPositiveSlope = (destFile - sourceFile) == (destRank - sourceRank);
-	wstring between;
-
-	for (TCHAR i = ChessInfo::EXCLUSIVE_SHIFT; i < (highFile - lowFile); i++)
-	{
-		if (isPositiveSlope) 
-		{
-			between = { (TCHAR)(lowFile + i), (TCHAR)(lowRank + i) };
-		}
-		else {
-			between = { (TCHAR)(lowFile + i), (TCHAR)(highRank - i) };
-		}
-
-		try
-		{
-			auto temp = board->at(between);
-			UNREFERENCED_PARAMETER(temp);
-			return false;
-		}
-		catch (const std::out_of_range& err)
-		{
-			UNREFERENCED_PARAMETER(err);
-			// No piece for this file & rank, no action required
-		}
-	}
-	return true;
+bool Piece::noDiagonalObstruction(int sourceSquare, int destSquare, const Position* board)
+{
+	return (betweenSquares(sourceSquare, destSquare) & board->occupied()) == EMPTY_BB;
 }
 
 /* Piece.destExistFriendlyPiece()
-   Pre-cond.: destFileRank is a valid file & rank representation
-   Post-cond.: return true if piece on the dest file & rank is a friendly,
+   Pre-cond.: destSquare is a valid square
+   Post-cond.: return true if piece on the dest square is a friendly,
 			   false otherwise (rivalry on dest or empty square)
 */
-bool Piece::destExistFriendlyPiece(wstring destFileRank, map<wstring, Piece*>* board) {
-
-	try
-	{
-		if (isFriendly(board->at(destFileRank)))
-		{
-			return true;
-		}
-	}
-	catch (const std::out_of_range& err)
-	{
-		UNREFERENCED_PARAMETER(err);
-		// No piece for this file & rank, expect to return false
-	}
-	return false;
+bool Piece::destExistFriendlyPiece(int destSquare, const Position* board) {
+
+	Piece* destPiece = board->pieceAt(destSquare);
+	return destPiece != nullptr && isFriendly(destPiece);
 }
 
 int Piece::Score()
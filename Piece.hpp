@@ -3,18 +3,19 @@
 
 /* Represent Implementation of a general piece in chess
    Including general, common methods a piece using to validate its own move
-	and hook methods clone(), isValidMove(), toString() and toGraphics()
+	and hook methods isValidMove(), toString() and toGraphics()
+   Pieces carry no per-game state: the board (Position) stores piece codes,
+	and fromCode() maps a code onto a shared instance of the matching Piece
 */
 
 #ifndef PIECES_H
 #define PIECES_H
 
-#include <map>
 #include <string>
 #include <cmath>
-#include <stdexcept>
 
 #include "ChessInfo.hpp"
+#include "Position.hpp"
 
 using namespace std;
 
@@ -22,23 +23,25 @@ class Piece {
 
 protected:
 	bool _isWhitePlayer;
-	bool _isKing = false;
-	bool isFirstMove = true;
+	PieceType _type;
 
 public:
-	Piece(bool isWhitePlayer);
+	Piece(bool isWhitePlayer, PieceType type);
 	virtual ~Piece() = 0;
 
-	// Piece.clone(): return a different object with same information of itself
-	virtual Piece* clone() = 0;
+	/* Piece.fromCode(): return the shared Piece standing for the given code
+	   (nullptr for NO_PIECE); the returned pieces must not be deleted
+	*/
+	static Piece* fromCode(PieceCode code);
 
-	void confirmMove();
 	bool isWhitePlayer();
 	bool isKing();
+	PieceType type();
+	PieceCode code();
 
 	/* Piece.isValidMove()
-	   Pre-cond.: sourceFileRank, destFileRank are valid file & rank rep.s
-				  board is a reference to an existing map implementation of
+	   Pre-cond.: sourceSquare, destSquare are valid squares (0 - 63)
+				  board is a reference to an existing Position holding the
 					current chess board situation
 	   Post-cond.: return 0 if the move is valid
 				   respective error code (defined in ChessErrHandler class)
@@ -50,7 +53,7 @@ public:
 			 Similar for checking friendlies in destination (Pawn has
 			   different check and error reporting logic)
 	*/
-	virtual int isValidMove(wstring sourceFileRank, wstring destFileRank, map<wstring, Piece*>* board) = 0;
+	virtual int isValidMove(int sourceSquare, int destSquare, const Position* board) = 0;
 
 	wstring playerToString();
 
@@ -63,18 +66,24 @@ public:
 protected:
 	bool isFriendly(Piece* that);
 
-	bool isSameFile(wstring sourceFileRank, wstring destFileRank);
-	bool isSameRank(wstring sourceFileRank, wstring destFileRank);
-	bool isSameDiagonal(wstring sourceFileRank, wstring destFileRank);
+	bool isSameFile(int sourceSquare, int destSquare);
+	bool isSameRank(int sourceSquare, int destSquare);
+	bool isSameDiagonal(int sourceSquare, int destSquare);
 
-	bool noVerticalObstruction(wstring sourceFileRank, wstring destFileRank, map<wstring, Piece*>* board);
-	bool noHorizontalObstruction(wstring sourceFileRank, wstring destFileRank, map<wstring, Piece*>* board);
-	bool noDiagonalObstruction(wstring sourceFileRank, wstring destFileRank, map<wstring, Piece*>* board);
+	bool noVerticalObstruction(int sourceSquare, int destSquare, const Position* board);
+	bool noHorizontalObstruction(int sourceSquare, int destSquare, const Position* board);
+	bool noDiagonalObstruction(int sourceSquare, int destSquare, const Position* board);
 
-	bool destExistFriendlyPiece(wstring destFileRank, map<wstring, Piece*>* board);
+	bool destExistFriendlyPiece(int destSquare, const Position* board);
 
 public:
 	virtual int Score() = 0; // Stefan-Mihai Moga
+
+	/* Material value of the piece once most pieces are off the board: the
+		 Pawns, nearer to promotion, and the Rooks gain, the minor pieces lose
+	   Score() is the value in the middlegame
+	*/
+	virtual int EndgameScore() = 0;
 };
 
 #include "ChessErrHandler.hpp"
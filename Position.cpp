@@ -0,0 +1,576 @@
+/* Copyright (C) 2024-2026 Stefan-Mihai MOGA
+This file is part of ChessCtrl application developed by Stefan-Mihai MOGA.
+Fully featured Chess Control written in C++ with the help of the MFC library.
+
+ChessCtrl is free software: you can redistribute it and/or modify it
+under the terms of the GNU General Public License as published by the Open
+Source Initiative, either version 3 of the License, or any later version.
+
+ChessCtrl is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+ChessCtrl. If not, see <http://www.opensource.org/licenses/gpl-3.0.html>*/
+
+// Position.cpp - Implementation of Position (info in Position.hpp)
+
+#include "Position.hpp"
+#include "Piece.hpp"
+#include <cctype>
+#include <cstring>
+
+const CastlingInfo castlingInfos[NUM_CASTLINGS] = {
+	{ WHITE_KING_SIDE, makeSquare(4, 0), makeSquare(6, 0), makeSquare(7, 0), makeSquare(5, 0) },
+	{ WHITE_QUEEN_SIDE, makeSquare(4, 0), makeSquare(2, 0), makeSquare(0, 0), makeSquare(3, 0) },
+	{ BLACK_KING_SIDE, makeSquare(4, 7), makeSquare(6, 7), makeSquare(7, 7), makeSquare(5, 7) },
+	{ BLACK_QUEEN_SIDE, makeSquare(4, 7), makeSquare(2, 7), makeSquare(0, 7), makeSquare(3, 7) }
+};
+
+/* Castling rights lost when a piece leaves or lands on a square: moving the
+	 King loses both of its side, moving (or losing) a Rook its own
+*/
+static int castlingRightsKept(int square)
+{
+	int kept = ALL_CASTLING;
+	for (int index = 0; index < NUM_CASTLINGS; index++)
+	{
+		if (castlingInfos[index].kingFrom == square || castlingInfos[index].rookFrom == square)
+		{
+			kept &= ~castlingInfos[index].right;
+		}
+	}
+	return kept;
+}
+
+const CastlingInfo* findCastling(int kingFrom, int kingTo)
+{
+	for (int index = 0; index < NUM_CASTLINGS; index++)
+	{
+		if (castlingInfos[index].kingFrom == kingFrom && castlingInfos[index].kingTo == kingTo)
+		{
+			return &castlingInfos[index];
+		}
+	}
+	return nullptr;
+}
+
+int squareFromFileRank(const wstring& fileRank)
+{
+	if (fileRank.length() != ChessInfo::FILERANK_LENGTH)
+	{
+		return ChessInfo::NO_SQUARE;
+	}
+
+	TCHAR file = fileRank.at(ChessInfo::FILE_INDEX);
+	TCHAR rank = fileRank.at(ChessInfo::RANK_INDEX);
+	if (file < ChessInfo::MIN_FILE || file > ChessInfo::MAX_FILE ||
+		rank < ChessInfo::MIN_RANK || rank > ChessInfo::MAX_RANK)
+	{
+		return ChessInfo::NO_SQUARE;
+	}
+	return makeSquare(file - ChessInfo::MIN_FILE, rank - ChessInfo::MIN_RANK);
+}
+
+wstring fileRankOf(int square)
+{
+	if (square < 0 || square >= ChessInfo::NUM_SQUARES)
+	{
+		return wstring(_T(""));
+	}
+	return wstring({ (TCHAR)(ChessInfo::MIN_FILE + fileOf(square)),
+		(TCHAR)(ChessInfo::MIN_RANK + rankOf(square)) });
+}
+
+string moveToString(Move move)
+{
+	static const char promotionLetters[] = " pnbrqk";
+	string text = {
+		(char)('a' + fileOf(moveFrom(move))), (char)('1' + rankOf(moveFrom(move))),
+		(char)('a' + fileOf(moveTo(move))), (char)('1' + rankOf(moveTo(move))) };
+	if (moveFlags(move) == PROMOTION_MOVE)
+	{
+		text += promotionLetters[movePromotion(move)];
+	}
+	return text;
+}
+
+Piece* Position::pieceAt(int square) const
+{
+	if (square < 0 || square >= ChessInfo::NUM_SQUARES)
+	{
+		return nullptr;
+	}
+	return Piece::fromCode(squares[square]);
+}
+
+bool Position::isEmpty(int square) const
+{
+	return square < 0 || square >= ChessInfo::NUM_SQUARES ||
+		squares[square] == NO_PIECE;
+}
+
+void Position::clear()
+{
+	for (int square = 0; square < ChessInfo::NUM_SQUARES; square++)
+	{
+		squares[square] = NO_PIECE;
+	}
+	for (int type = NO_PIECE_TYPE; type <= KING; type++)
+	{
+		byType[type] = EMPTY_BB;
+	}
+	byColour[0] = byColour[1] = EMPTY_BB;
+	isWhiteTurn = true;
+	castlingRights = NO_CASTLING;
+	epSquare = ChessInfo::NO_SQUARE;
+	halfmoveClock = 0;
+	fullmoveNumber = 1;
+	key = 0;
+	pawnKey = 0;
+	pieceSquareScore[MIDDLEGAME] = pieceSquareScore[ENDGAME] = 0;
+	phase = 0;
+	accumulator.isComputed[0] = accumulator.isComputed[1] = false;
+	accumulator.network = nullptr;
+}
+
+// A move counter of the FEN string, up to the next space or the end
+static bool readCounter(const char*& c, int& counter)
+{
+	if (*c < '0' || *c > '9')
+	{
+		return false;
+	}
+	counter = 0;
+	for (; *c >= '0' && *c <= '9'; c++)
+	{
+		if (counter > 100000)
+		{
+			return false;
+		}
+		counter = counter * 10 + (*c - '0');
+	}
+	return *c == ' ' || *c == '\0';
+}
+
+// The first and last ranks
+static const Bitboard BACK_RANKS = 0xFF000000000000FFULL;
+
+/* Position.loadFEN():
+   Parse the fields in place, one character at a time: the ranks from 8
+	 down to 1 separated by '/', digits for runs of empty squares; then 'w'
+	 or 'b'; then "-" or any of "KQkq"; then "-" or the en passant square;
+	 then the halfmove clock and the fullmove number (each of the last three
+	 fields may be left out, with the ones after it)
+*/
+bool Position::loadFEN(const char* fen)
+{
+	static const char pieceLetters[] = " PNBRQK";
+	clear();
+
+	const char* c = fen;
+	int file = 0;
+	int rank = ChessInfo::NUM_RANKS - 1;
+	for (; *c != ' '; c++)
+	{
+		if (*c == '\0')
+		{
+			return false;
+		}
+		if (*c == '/')
+		{
+			if (file != ChessInfo::NUM_FILES || rank == 0)
+			{
+				return false;
+			}
+			file = 0;
+			rank--;
+		}
+		else if (*c >= '1' && *c <= '8')
+		{
+			file += *c - '0';
+		}
+		else
+		{
+			const char* letter = strchr(pieceLetters + 1, toupper((unsigned char)*c));
+			if (letter == nullptr || *letter == '\0' || file >= ChessInfo::NUM_FILES)
+			{
+				return false;
+			}
+			putPiece(makeSquare(file++, rank),
+				makePieceCode((PieceType)(letter - pieceLetters), isupper((unsigned char)*c) != 0));
+		}
+		if (file > ChessInfo::NUM_FILES)
+		{
+			return false;
+		}
+	}
+	if (file != ChessInfo::NUM_FILES || rank != 0)
+	{
+		return false;
+	}
+	// A Pawn never stands on the first or last rank, and each side has one King
+	if ((byType[PAWN] & BACK_RANKS) != EMPTY_BB ||
+		popCount(piecesOf(KING, true)) != 1 || popCount(piecesOf(KING, false)) != 1)
+	{
+		return false;
+	}
+
+	c++;
+	if (*c != 'w' && *c != 'b')
+	{
+		return false;
+	}
+	isWhiteTurn = *c++ == 'w';
+	if (*c++ != ' ')
+	{
+		return false;
+	}
+
+	if (*c == '-')
+	{
+		c++;
+	}
+	else
+	{
+		for (; *c != ' ' && *c != '\0'; c++)
+		{
+			switch (*c)
+			{
+				case 'K': castlingRights |= WHITE_KING_SIDE; break;
+				case 'Q': castlingRights |= WHITE_QUEEN_SIDE; break;
+				case 'k': castlingRights |= BLACK_KING_SIDE; break;
+				case 'q': castlingRights |= BLACK_QUEEN_SIDE; break;
+				default: return false;
+			}
+		}
+	}
+	if (*c != ' ' && *c != '\0')
+	{
+		return false;
+	}
+	if (*c == ' ' && *++c != '-')
+	{
+		if (c[0] < 'a' || c[0] > 'h' || c[1] < '1' || c[1] > '8')
+		{
+			return false;
+		}
+		epSquare = makeSquare(c[0] - 'a', c[1] - '1');
+		c++;
+		// The square a rival Pawn just skipped: empty, with that Pawn in front of it
+		int pawnSquare = isWhiteTurn ? epSquare - ChessInfo::NUM_FILES : epSquare + ChessInfo::NUM_FILES;
+		if (rankOf(epSquare) != (isWhiteTurn ? 5 : 2) || squares[epSquare] != NO_PIECE ||
+			squares[pawnSquare] != makePieceCode(PAWN, !isWhiteTurn))
+		{
+			return false;
+		}
+	}
+	if (*c != '\0' && *++c != ' ' && *c != '\0')
+	{
+		return false;
+	}
+
+	if (*c == ' ' && (!readCounter(++c, halfmoveClock) ||
+		(*c == ' ' && !readCounter(++c, fullmoveNumber))))
+	{
+		return false;
+	}
+	if (*c != '\0')
+	{
+		return false;
+	}
+
+	key = computeKey();
+	return true;
+}
+
+string Position::toFEN() const
+{
+	static const char pieceLetters[] = " PNBRQK";
+	string fen;
+	for (int rank = ChessInfo::NUM_RANKS - 1; rank >= 0; rank--)
+	{
+		int emptyCount = 0;
+		for (int file = 0; file < ChessInfo::NUM_FILES; file++)
+		{
+			PieceCode code = squares[makeSquare(file, rank)];
+			if (code == NO_PIECE)
+			{
+				emptyCount++;
+				continue;
+			}
+			if (emptyCount > 0)
+			{
+				fen += (char)('0' + emptyCount);
+				emptyCount = 0;
+			}
+			char letter = pieceLetters[typeOf(code)];
+			fen += isWhitePiece(code) ? letter : (char)tolower(letter);
+		}
+		if (emptyCount > 0)
+		{
+			fen += (char)('0' + emptyCount);
+		}
+		if (rank > 0)
+		{
+			fen += '/';
+		}
+	}
+
+	fen += isWhiteTurn ? " w " : " b ";
+	if (castlingRights == NO_CASTLING)
+	{
+		fen += '-';
+	}
+	if (castlingRights & WHITE_KING_SIDE) fen += 'K';
+	if (castlingRights & WHITE_QUEEN_SIDE) fen += 'Q';
+	if (castlingRights & BLACK_KING_SIDE) fen += 'k';
+	if (castlingRights & BLACK_QUEEN_SIDE) fen += 'q';
+
+	fen += ' ';
+	if (epSquare == ChessInfo::NO_SQUARE)
+	{
+		fen += '-';
+	}
+	else
+	{
+		fen += (char)('a' + fileOf(epSquare));
+		fen += (char)('1' + rankOf(epSquare));
+	}
+	fen += ' ' + to_string(halfmoveClock) + ' ' + to_string(fullmoveNumber);
+	return fen;
+}
+
+void Position::putPiece(int square, PieceCode code)
+{
+	squares[square] = code;
+	key ^= zobristPieces[code][square];
+	if (typeOf(code) == PAWN)
+	{
+		pawnKey ^= zobristPieces[code][square];
+	}
+	pieceSquareScore[MIDDLEGAME] += pieceSquareScores[MIDDLEGAME][code][square];
+	pieceSquareScore[ENDGAME] += pieceSquareScores[ENDGAME][code][square];
+	phase += piecePhases[code];
+	byType[typeOf(code)] |= squareBB(square);
+	byColour[isWhitePiece(code) ? 0 : 1] |= squareBB(square);
+	if (accumulator.network != nullptr)
+	{
+		accumulatorPut(this, square, code);
+	}
+}
+
+void Position::removePiece(int square)
+{
+	PieceCode code = squares[square];
+	if (code == NO_PIECE)
+	{
+		return;
+	}
+	squares[square] = NO_PIECE;
+	key ^= zobristPieces[code][square];
+	if (typeOf(code) == PAWN)
+	{
+		pawnKey ^= zobristPieces[code][square];
+	}
+	pieceSquareScore[MIDDLEGAME] -= pieceSquareScores[MIDDLEGAME][code][square];
+	pieceSquareScore[ENDGAME] -= pieceSquareScores[ENDGAME][code][square];
+	phase -= piecePhases[code];
+	byType[typeOf(code)] &= ~squareBB(square);
+	byColour[isWhitePiece(code) ? 0 : 1] &= ~squareBB(square);
+	if (accumulator.network != nullptr)
+	{
+		accumulatorRemove(this, square, code);
+	}
+}
+
+/* Position.movePiece():
+   pre-cond.: sourceSquare holds a piece
+   Conduct the move (or capture) and return the captured piece code,
+	 NO_PIECE if the destination was empty
+   N.B.: The side to move is left untouched, it is up to the caller
+*/
+PieceCode Position::movePiece(int sourceSquare, int destSquare)
+{
+	PieceCode moving = squares[sourceSquare];
+	PieceCode captured = squares[destSquare];
+	removePiece(destSquare);
+	removePiece(sourceSquare);
+	putPiece(destSquare, moving);
+	return captured;
+}
+
+/* Position.makeMove():
+   Besides moving the piece: castling also moves the Rook next to the King,
+	 en passant takes the Pawn standing behind the destination and a
+	 promotion replaces the Pawn by the piece promoted to
+*/
+PieceCode Position::makeMove(Move move, UndoRecord& undo)
+{
+	int from = moveFrom(move);
+	int to = moveTo(move);
+	PieceCode moving = squares[from];
+	PieceCode captured = NO_PIECE;
+	undo.key = key;
+
+	if (moveFlags(move) == EN_PASSANT_MOVE)
+	{
+		int capturedSquare = makeSquare(fileOf(to), rankOf(from));
+		captured = squares[capturedSquare];
+		removePiece(capturedSquare);
+		movePiece(from, to);
+	}
+	else
+	{
+		captured = movePiece(from, to);
+	}
+
+	if (moveFlags(move) == PROMOTION_MOVE)
+	{
+		removePiece(to);
+		putPiece(to, makePieceCode((PieceType)movePromotion(move), isWhiteTurn));
+	}
+	else if (moveFlags(move) == CASTLING_MOVE)
+	{
+		const CastlingInfo* castling = findCastling(from, to);
+		movePiece(castling->rookFrom, castling->rookTo);
+	}
+
+	undo.captured = captured;
+	undo.castlingRights = castlingRights;
+	undo.epSquare = epSquare;
+	undo.halfmoveClock = halfmoveClock;
+
+	halfmoveClock = (captured != NO_PIECE || typeOf(moving) == PAWN) ? 0 : halfmoveClock + 1;
+	if (!isWhiteTurn)
+	{
+		fullmoveNumber++;
+	}
+
+	key ^= zobristCastling[castlingRights];
+	castlingRights &= castlingRightsKept(from) & castlingRightsKept(to);
+	key ^= zobristCastling[castlingRights];
+
+	if (epSquare != ChessInfo::NO_SQUARE)
+	{
+		key ^= zobristEnPassant[fileOf(epSquare)];
+	}
+	bool isDoubleStep = typeOf(moving) == PAWN &&
+		abs(rankOf(to) - rankOf(from)) == 2;
+	epSquare = isDoubleStep ? (from + to) / 2 : ChessInfo::NO_SQUARE;
+	if (epSquare != ChessInfo::NO_SQUARE)
+	{
+		key ^= zobristEnPassant[fileOf(epSquare)];
+	}
+
+	isWhiteTurn = !isWhiteTurn;
+	key ^= zobristBlackToMove;
+	return captured;
+}
+
+/* Position.unmakeMove():
+   Mirror of makeMove(): the piece goes back (as a Pawn if it was promoted),
+	 the captured piece comes back on its square, the Rook returns to its
+	 corner after a castling, and the state saved in the record (the key
+	 included) is restored
+*/
+void Position::unmakeMove(Move move, const UndoRecord& undo)
+{
+	int from = moveFrom(move);
+	int to = moveTo(move);
+	isWhiteTurn = !isWhiteTurn;
+	castlingRights = undo.castlingRights;
+	epSquare = undo.epSquare;
+	halfmoveClock = undo.halfmoveClock;
+	if (!isWhiteTurn)
+	{
+		fullmoveNumber--;
+	}
+
+	if (moveFlags(move) == PROMOTION_MOVE)
+	{
+		removePiece(to);
+		putPiece(from, makePieceCode(PAWN, isWhiteTurn));
+	}
+	else
+	{
+		movePiece(to, from);
+	}
+
+	if (moveFlags(move) == CASTLING_MOVE)
+	{
+		const CastlingInfo* castling = findCastling(from, to);
+		movePiece(castling->rookTo, castling->rookFrom);
+	}
+	else if (undo.captured != NO_PIECE)
+	{
+		int capturedSquare = moveFlags(move) == EN_PASSANT_MOVE ?
+			makeSquare(fileOf(to), rankOf(from)) : to;
+		putPiece(capturedSquare, undo.captured);
+	}
+	key = undo.key;
+}
+
+Key Position::computeKey() const
+{
+	Key result = zobristCastling[castlingRights];
+	for (int square = 0; square < ChessInfo::NUM_SQUARES; square++)
+	{
+		if (squares[square] != NO_PIECE)
+		{
+			result ^= zobristPieces[squares[square]][square];
+		}
+	}
+	if (epSquare != ChessInfo::NO_SQUARE)
+	{
+		result ^= zobristEnPassant[fileOf(epSquare)];
+	}
+	if (!isWhiteTurn)
+	{
+		result ^= zobristBlackToMove;
+	}
+	return result;
+}
+
+/* Position.isAttacked():
+   Look from the square outwards with each kind of move, a piece of the
+	 attacking side found at the end of such a move attacks the square
+	 (pawns are looked for with the captures of a pawn of the defending side)
+*/
+bool Position::isAttacked(int square, bool byWhitePlayer) const
+{
+	Bitboard attackers = piecesOf(byWhitePlayer);
+	Bitboard rooksQueens = byType[ROOK] | byType[QUEEN];
+	Bitboard bishopsQueens = byType[BISHOP] | byType[QUEEN];
+
+	return (pawnAttacks(square, !byWhitePlayer) & byType[PAWN] & attackers) ||
+		(knightAttacks(square) & byType[KNIGHT] & attackers) ||
+		(kingAttacks(square) & byType[KING] & attackers) ||
+		(rookAttacks(square, occupied()) & rooksQueens & attackers) ||
+		(bishopAttacks(square, occupied()) & bishopsQueens & attackers);
+}
+
+bool Position::inCheck() const
+{
+	int kingSquare = findKing(isWhiteTurn);
+	return kingSquare != ChessInfo::NO_SQUARE && isAttacked(kingSquare, !isWhiteTurn);
+}
+
+/* Position.castlingPathIsClear():
+   The right is still there, the Rook is on its corner and every square
+	 between King and Rook is empty (being attacked is not checked here)
+*/
+bool Position::castlingPathIsClear(const CastlingInfo& castling) const
+{
+	bool isWhiteCastling = castling.right == WHITE_KING_SIDE || castling.right == WHITE_QUEEN_SIDE;
+	return (castlingRights & castling.right) != 0 &&
+		squares[castling.kingFrom] == makePieceCode(KING, isWhiteCastling) &&
+		squares[castling.rookFrom] == makePieceCode(ROOK, isWhiteCastling) &&
+		(betweenSquares(castling.kingFrom, castling.rookFrom) & occupied()) == EMPTY_BB;
+}
+
+int Position::findKing(bool isWhitePlayer) const
+{
+	Bitboard king = piecesOf(KING, isWhitePlayer);
+	return king != EMPTY_BB ? lsbSquare(king) : ChessInfo::NO_SQUARE;
+}
@@ -0,0 +1,226 @@
+/* Copyright (C) 2024-2026 Stefan-Mihai MOGA
+This file is part of ChessCtrl application developed by Stefan-Mihai MOGA.
+Fully featured Chess Control written in C++ with the help of the MFC library.
+
+ChessCtrl is free software: you can redistribute it and/or modify it
+under the terms of the GNU General Public License as published by the Open
+Source Initiative, either version 3 of the License, or any later version.
+
+ChessCtrl is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+ChessCtrl. If not, see <http://www.opensource.org/licenses/gpl-3.0.html>*/
+
+// Position.hpp - Position
+/* Compact representation of a chess position shared by ChessBoard, Piece
+	 and the computer player: a 64-square mailbox holding one byte per square
+	 plus the side to move
+   Squares are numbered from A1 = 0, B1 = 1, ... to H8 = 63, so that the
+	 file is (square % 8) and the rank is (square / 8)
+   A square holds NO_PIECE or a PieceCode: the PieceType in the low three
+	 bits, with BLACK_FLAG set for pieces belonging to the Black player
+   The mailbox is mirrored by bitboards, one per piece type and one per
+	 colour, so the pieces must be placed & removed through putPiece(),
+	 removePiece() and movePiece() to keep both views in step
+   Besides the pieces, a position records which castlings are still
+	 allowed and the square a Pawn skipped with its double step on the last
+	 move (the en passant square), both kept up to date by makeMove()
+   makeMove() fills an UndoRecord supplied by the caller with whatever the
+	 move destroys, unmakeMove() uses it to restore the position in place:
+	 a search keeps one record per ply instead of copying the position
+   The Zobrist key of the position is updated along with the pieces and
+	 the state by the same methods; whoever sets castlingRights, epSquare
+	 or isWhiteTurn directly has to set key to computeKey() afterwards
+   So are pawnKey, the Zobrist key of the Pawns alone, pieceSquareScore,
+	 the material and piece-square score of the pieces from White's point of
+	 view in the middlegame and in the endgame, and the game phase (see
+	 Evaluate.hpp), by putPiece() and removePiece(), and while a search
+	 binds the position to a network, the accumulator of its feature
+	 transformer (see Nnue.hpp)
+*/
+
+#ifndef POSITION_H
+#define POSITION_H
+
+#include <string>
+
+#include "ChessInfo.hpp"
+#include "Bitboard.hpp"
+#include "Move.hpp"
+#include "Zobrist.hpp"
+#include "Evaluate.hpp"
+#include "Nnue.hpp"
+
+using namespace std;
+
+class Piece;
+
+enum PieceType { NO_PIECE_TYPE = 0, PAWN, KNIGHT, BISHOP, ROOK, QUEEN, KING };
+
+typedef unsigned char PieceCode;
+
+static const PieceCode NO_PIECE = 0;
+static const PieceCode BLACK_FLAG = 8;
+static const PieceCode TYPE_MASK = 7;
+
+inline PieceCode makePieceCode(PieceType type, bool isWhitePlayer)
+{
+	return (PieceCode)(isWhitePlayer ? type : (type | BLACK_FLAG));
+}
+
+inline PieceType typeOf(PieceCode code)
+{
+	return (PieceType)(code & TYPE_MASK);
+}
+
+inline bool isWhitePiece(PieceCode code)
+{
+	return (code & BLACK_FLAG) == 0;
+}
+
+inline int makeSquare(int file, int rank)
+{
+	return rank * ChessInfo::NUM_FILES + file;
+}
+
+inline int fileOf(int square)
+{
+	return square % ChessInfo::NUM_FILES;
+}
+
+inline int rankOf(int square)
+{
+	return square / ChessInfo::NUM_FILES;
+}
+
+enum CastlingRight {
+	NO_CASTLING = 0,
+	WHITE_KING_SIDE = 1, WHITE_QUEEN_SIDE = 2,
+	BLACK_KING_SIDE = 4, BLACK_QUEEN_SIDE = 8,
+	ALL_CASTLING = 15
+};
+
+/* CastlingInfo:
+   The squares involved in each castling, castlingInfos[] is in the order of
+	 the CastlingRight bits (White King side first)
+*/
+struct CastlingInfo {
+	int right;
+	int kingFrom;
+	int kingTo;
+	int rookFrom;
+	int rookTo;
+};
+
+static const int NUM_CASTLINGS = 4;
+extern const CastlingInfo castlingInfos[NUM_CASTLINGS];
+
+// The castling a King moving from kingFrom to kingTo performs, nullptr if none
+const CastlingInfo* findCastling(int kingFrom, int kingTo);
+
+/* Conversions between the file & rank representation used by the user
+	 interface (e.g. "E2") and square numbers
+   squareFromFileRank() returns ChessInfo::NO_SQUARE for anything that is not
+	 a valid file & rank representation
+*/
+int squareFromFileRank(const wstring& fileRank);
+wstring fileRankOf(int square);
+
+// Coordinate notation of a move, e.g. "e2e4" or "e7e8q" for a promotion
+string moveToString(Move move);
+
+// The initial position of a game
+static const char* const START_FEN = "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1";
+
+struct UndoRecord {
+	PieceCode captured;
+	int castlingRights;
+	int epSquare;
+	int halfmoveClock;
+	Key key;
+};
+
+struct Position {
+	PieceCode squares[ChessInfo::NUM_SQUARES];
+	Bitboard byType[KING + 1];
+	Bitboard byColour[2];
+	bool isWhiteTurn;
+	int castlingRights;
+	int epSquare;
+	int halfmoveClock;
+	int fullmoveNumber;
+	Key key;
+	Key pawnKey;
+	int pieceSquareScore[NUM_GAME_PHASES];
+	int phase;
+	Accumulator accumulator;
+
+	/* Non-throwing square lookups:
+	   pieceAt() returns the Piece standing on the square, nullptr if the
+		 square is empty (or not on the board)
+	   isEmpty() returns true if there is no piece on the square
+	*/
+	Piece* pieceAt(int square) const;
+	bool isEmpty(int square) const;
+
+	// Occupancy of the whole board / of one side / of one side's pieces of a type
+	Bitboard occupied() const { return byColour[0] | byColour[1]; }
+	Bitboard piecesOf(bool isWhitePlayer) const { return byColour[isWhitePlayer ? 0 : 1]; }
+	Bitboard piecesOf(PieceType type, bool isWhitePlayer) const { return byType[type] & piecesOf(isWhitePlayer); }
+
+	/* Empty the board, White to move, no castling & no en passant square,
+		 move counters as at the start of a game
+	*/
+	void clear();
+
+	/* Set up the position described by a FEN string: piece placement, side
+		 to move, castling rights, en passant square, then the halfmove clock
+		 (plies since the last capture or Pawn move) and the fullmove number
+	   The en passant square and the counters may be left out (they then are
+		 "-", 0 and 1); nothing is allocated, so any number of positions can
+		 be set up cheaply
+	   Return false, leaving the position undefined, if fen is malformed or
+		 sets up an impossible board: a Pawn on the first or last rank, a
+		 side without a King or with more than one, an en passant square
+		 which no rival Pawn can just have skipped
+	*/
+	bool loadFEN(const char* fen);
+
+	// The FEN string of the position, move counters included
+	string toFEN() const;
+
+	// Place a piece on an empty square / take the piece off a square
+	void putPiece(int square, PieceCode code);
+	void removePiece(int square);
+
+	// Move the piece on source to destination, returning what was captured
+	PieceCode movePiece(int sourceSquare, int destSquare);
+
+	/* Play the move (pre-cond.: pseudo-legal for the side to move) including
+		 its special effects, update castling rights, en passant square and
+		 move counters and pass the turn; return the captured piece code,
+		 NO_PIECE if none
+	   unmakeMove() takes back the last move made, given the same record
+	*/
+	PieceCode makeMove(Move move, UndoRecord& undo);
+	void unmakeMove(Move move, const UndoRecord& undo);
+
+	// The Zobrist key of the position computed from scratch
+	Key computeKey() const;
+
+	// True if any piece of the given side attacks the square
+	bool isAttacked(int square, bool byWhitePlayer) const;
+
+	// True if the side to move has its King attacked
+	bool inCheck() const;
+
+	// True if castling is still allowed and no piece stands in between
+	bool castlingPathIsClear(const CastlingInfo& castling) const;
+
+	// Square of the given side's King, ChessInfo::NO_SQUARE if there is none
+	int findKing(bool isWhitePlayer) const;
+};
+
+#endif
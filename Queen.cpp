@@ -1,10 +1,9 @@
 // Bryan Liu (chl312), Dept. of Computing, Imperial College London
 // Queen.cpp - implementation of Queen extending Piece (info in Queen.hpp)
 
-#include "pch.h"
 #include "Queen.hpp"
 
-Queen::Queen(bool isWhitePlayer) : Piece(isWhitePlayer)
+Queen::Queen(bool isWhitePlayer) : Piece(isWhitePlayer, QUEEN)
 {
 }
 
@@ -12,10 +11,6 @@ Queen::~Queen()
 {
 }
 
-Queen* Queen::clone() {
-	return new Queen(this->isWhitePlayer());
-}
-
 /* A Queen's move is valid if:
    - Destination is on the same file/rank/diagonal (note: mutually exclusive)
    - There are no other pieces in intermediate spaces
@@ -25,37 +20,28 @@ Queen* Queen::clone() {
    Queen.isValidMove() post-cond: return 0 if move is valid
 								  respective error code otherwise
 */
-int Queen::isValidMove(wstring sourceFileRank, wstring destFileRank, map<wstring, Piece*>* board)
+int Queen::isValidMove(int sourceSquare, int destSquare, const Position* board)
 {
 
-	if (isSameFile(sourceFileRank, destFileRank) &&
-		isSameRank(sourceFileRank, destFileRank))
+	if (isSameFile(sourceSquare, destSquare) &&
+		isSameRank(sourceSquare, destSquare))
 	{
 		return ChessErrHandler::DEST_EQ_SOURCE;
 	}
 
-	if (!(isSameFile(sourceFileRank, destFileRank) ||
-		isSameRank(sourceFileRank, destFileRank) ||
-		isSameDiagonal(sourceFileRank, destFileRank)))
+	if (!(isSameFile(sourceSquare, destSquare) ||
+		isSameRank(sourceSquare, destSquare) ||
+		isSameDiagonal(sourceSquare, destSquare)))
 	{
 		return ChessErrHandler::ILLEGAL_MOVE_PATTERN;
 	}
 
-	/* Obstruction for a Queen only occurs if it is on its intended way
-	   Lazy boolean evalution of C++ ensure !no_Obstruction is evaluated
-		only after isSame_ is satisfied, preventing breaking pre-cond of
-		no_Obstruction methods
-	*/
-	if ((isSameFile(sourceFileRank, destFileRank) &&
-		!noVerticalObstruction(sourceFileRank, destFileRank, board)) ||
-		(isSameRank(sourceFileRank, destFileRank) &&
-			!noHorizontalObstruction(sourceFileRank, destFileRank, board)) ||
-		(isSameDiagonal(sourceFileRank, destFileRank) &&
-			!noDiagonalObstruction(sourceFileRank, destFileRank, board))) {
+	// The Queen attacks up to (and including) the first piece in each direction
+	if (!testSquare(queenAttacks(sourceSquare, board->occupied()), destSquare)) {
 		return ChessErrHandler::OBSTRUCTION_EN_ROUTE;
 	}
 
-	if (destExistFriendlyPiece(destFileRank, board)) {
+	if (destExistFriendlyPiece(destSquare, board)) {
 		return ChessErrHandler::FRIENDLY_AT_DEST;
 	}
 
@@ -84,5 +70,10 @@ wstring Queen::toGraphics()
 
 int Queen::Score()
 {
-	return 100;
+	return 900;
+}
+
+int Queen::EndgameScore()
+{
+	return 950;
 }
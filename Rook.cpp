@@ -1,10 +1,9 @@
 // Bryan Liu (chl312), Dept. of Computing, Imperial College London
 // Rook.cpp - implementation of Rook extending Piece (info in Rook.hpp)
 
-#include "pch.h"
 #include "Rook.hpp"
 
-Rook::Rook(bool isWhitePlayer) : Piece(isWhitePlayer)
+Rook::Rook(bool isWhitePlayer) : Piece(isWhitePlayer, ROOK)
 {
 }
 
@@ -12,11 +11,6 @@ Rook::~Rook()
 {
 }
 
-Rook* Rook::clone()
-{
-	return new Rook(this->isWhitePlayer());
-}
-
 /* A Rook's move is valid if:
    - Destination is on the same file/rank (note: mutually exclusive)
    - There are no other pieces in intermediate spaces
@@ -26,34 +20,28 @@ Rook* Rook::clone()
    Rook.isValidMove() post-cond: return 0 if move is valid
 								 respective error code otherwise
 */
-int Rook::isValidMove(wstring sourceFileRank, wstring destFileRank, map<wstring, Piece*>* board)
+int Rook::isValidMove(int sourceSquare, int destSquare, const Position* board)
 {
 
-	if (isSameFile(sourceFileRank, destFileRank) &&
-		isSameRank(sourceFileRank, destFileRank))
+	if (isSameFile(sourceSquare, destSquare) &&
+		isSameRank(sourceSquare, destSquare))
 	{
 		return ChessErrHandler::DEST_EQ_SOURCE;
 	}
 
-	if (!(isSameFile(sourceFileRank, destFileRank) ||
-		isSameRank(sourceFileRank, destFileRank)))
+	if (!(isSameFile(sourceSquare, destSquare) ||
+		isSameRank(sourceSquare, destSquare)))
 	{
 		return ChessErrHandler::ILLEGAL_MOVE_PATTERN;
 	}
 
-	/* Obstruction for a Rook only occurs if it is on its intended way
-	   Lazy boolean evalution of C++ ensure !no_Obstruction is evaluated only
-		after satisfying isSame_, prevents breaking pre-cond of no_Obstruction
-	*/
-	if ((isSameFile(sourceFileRank, destFileRank) &&
-		!noVerticalObstruction(sourceFileRank, destFileRank, board)) ||
-		(isSameRank(sourceFileRank, destFileRank) &&
-			!noHorizontalObstruction(sourceFileRank, destFileRank, board))) 
+	// The Rook attacks up to (and including) the first piece on its file/rank
+	if (!testSquare(rookAttacks(sourceSquare, board->occupied()), destSquare))
 	{
 		return ChessErrHandler::OBSTRUCTION_EN_ROUTE;
 	}
 
-	if (destExistFriendlyPiece(destFileRank, board))
+	if (destExistFriendlyPiece(destSquare, board))
 	{
 		return ChessErrHandler::FRIENDLY_AT_DEST;
 	}
@@ -82,5 +70,10 @@ wstring Rook::toGraphics()
 
 int Rook::Score()
 {
-	return 10;
+	return 500;
+}
+
+int Rook::EndgameScore()
+{
+	return 540;
 }
@@ -2,14 +2,13 @@
 // Rook.hpp - Rook extending Piece
 
 /* Represent Implementation of a Rook piece in chess
-   Including concrete implementation of clone(), isValidMove(), toString()
+   Including concrete implementation of isValidMove(), toString()
 	 and toGraphics(), inherited from abstract superclass Piece
 */
 
 #ifndef ROOK_H
 #define ROOK_H
 
-#include <map>
 #include <string>
 
 #include "Piece.hpp"
@@ -19,13 +18,13 @@ class Rook : public Piece {
 public:
 	Rook(bool isWhitePlayer);
 	~Rook();
-	Rook* clone();
 
-	int isValidMove(wstring sourceFileRank, wstring destFileRank, map<wstring, Piece*>* board);
+	int isValidMove(int sourceSquare, int destSquare, const Position* board);
 	wstring toString();
 	wstring toGraphics();
 public:
 	int Score(); // Stefan-Mihai Moga
+	int EndgameScore();
 };
 
 #endif
@@ -0,0 +1,558 @@
+/* Copyright (C) 2024-2026 Stefan-Mihai MOGA
+This file is part of ChessCtrl application developed by Stefan-Mihai MOGA.
+Fully featured Chess Control written in C++ with the help of the MFC library.
+
+ChessCtrl is free software: you can redistribute it and/or modify it
+under the terms of the GNU General Public License as published by the Open
+Source Initiative, either version 3 of the License, or any later version.
+
+ChessCtrl is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+ChessCtrl. If not, see <http://www.opensource.org/licenses/gpl-3.0.html>*/
+
+// Search.cpp - Implementation of Search (info in Search.hpp)
+
+#include "Search.hpp"
+#include <memory>
+#include <thread>
+#include <vector>
+#include <cstdlib>
+
+// Allowance for positional gains when pruning hopeless captures, two Pawns
+static const int DELTA_MARGIN = 200;
+
+Search::Search(TranspositionTable* table, const std::atomic<bool>* stopSignal)
+{
+	_table = table;
+	_threads = 1;
+	_threadIndex = 0;
+	_stopHelpers = false;
+	_stopSignal = stopSignal;
+	_observer = nullptr;
+	_isStopped = false;
+	_rootDepth = 0;
+	_rootMove = NO_MOVE;
+	_nodes = 0;
+	_evalProbes = 0;
+	_evalHits = 0;
+	for (int ply = 0; ply < MAX_PLY; ply++)
+	{
+		_pvLength[ply] = 0;
+	}
+	clearHeuristics();
+}
+
+void Search::clearHeuristics()
+{
+	for (int ply = 0; ply < MAX_PLY; ply++)
+	{
+		for (int index = 0; index < NUM_KILLERS; index++)
+		{
+			_killers[ply][index] = NO_MOVE;
+		}
+	}
+	for (int side = 0; side < 2; side++)
+	{
+		for (int from = 0; from < ChessInfo::NUM_SQUARES; from++)
+		{
+			for (int to = 0; to < ChessInfo::NUM_SQUARES; to++)
+			{
+				_history[side][from][to] = 0;
+			}
+		}
+	}
+}
+
+/* Search.perturbHistory():
+   Helper threads start with small pseudo-random history scores, different
+	 for each helper, so that their quiet moves come in another order
+*/
+void Search::perturbHistory()
+{
+	unsigned long long state = 0x9E3779B97F4A7C15ULL * (unsigned long long)_threadIndex;
+	for (int side = 0; side < 2; side++)
+	{
+		for (int from = 0; from < ChessInfo::NUM_SQUARES; from++)
+		{
+			for (int to = 0; to < ChessInfo::NUM_SQUARES; to++)
+			{
+				state ^= state >> 12;
+				state ^= state << 25;
+				state ^= state >> 27;
+				_history[side][from][to] = (int)((state * 2685821657736338717ULL) >> 58);
+			}
+		}
+	}
+}
+
+/* Search.updateHistory():
+   Move the history score towards +MAX_HISTORY (the move caused a cut-off)
+	 or -MAX_HISTORY (it was searched before the move which did) by an amount
+	 growing with the depth, the closer to the bound the smaller the step
+*/
+void Search::updateHistory(bool isWhite, Move move, int bonus)
+{
+	int& score = _history[isWhite ? 0 : 1][moveFrom(move)][moveTo(move)];
+	score += bonus - score * abs(bonus) / MAX_HISTORY;
+}
+
+// The quiet move caused a cut-off at this ply, remember it for its siblings
+void Search::storeKiller(int ply, Move move)
+{
+	if (_killers[ply][0] != move)
+	{
+		for (int index = NUM_KILLERS - 1; index > 0; index--)
+		{
+			_killers[ply][index] = _killers[ply][index - 1];
+		}
+		_killers[ply][0] = move;
+	}
+}
+
+void Search::setThreads(int threads)
+{
+	_threads = threads > 1 ? threads : 1;
+}
+
+void Search::setObserver(SearchObserver* observer)
+{
+	_observer = observer;
+}
+
+/* Search.think():
+   Start the helper threads, each with a copy of the position, search on
+	 the calling thread until a limit is reached, then stop & join the
+	 helpers and keep the deepest completed iteration
+   The helpers are kept for the next search (with their Pawn hash tables),
+	 only added or dropped when the number of threads changes
+*/
+SearchResult Search::think(Position* board, const SearchLimits& limits)
+{
+	_limits = limits;
+	_time.start(limits);
+	_stopHelpers = false;
+	if (_table != nullptr)
+	{
+		_table->newSearch();
+	}
+	/* The network in use now is the one of the whole search, held until the
+		 next; the scores cached under another one are thrown away
+	*/
+	std::shared_ptr<const Network> network = currentNetwork();
+	if (network != nullptr)
+	{
+		if (_evalCache == nullptr)
+		{
+			_evalCache = std::make_shared<EvalCache>();
+		}
+		else if (network != _network)
+		{
+			_evalCache->clear();
+		}
+	}
+	_network = network;
+	refreshAccumulator(board, _network.get());
+
+	int helperCount = _threads - 1;
+	while ((int)_helpers.size() < helperCount)
+	{
+		_helpers.emplace_back(new Search(_table));
+	}
+	_helpers.resize(helperCount);
+	std::vector<Position> helperBoards(helperCount, *board);
+	std::vector<SearchResult> helperResults(helperCount);
+	std::vector<std::thread> helperThreads;
+	for (int index = 0; index < helperCount; index++)
+	{
+		Search* helper = _helpers[index].get();
+		helper->_threadIndex = index + 1;
+		helper->_stopSignal = &_stopHelpers;
+		helper->_limits.depth = limits.depth;
+		helper->_evalCache = _evalCache;
+		helper->_network = _network;
+		helper->_time = _time;
+	}
+	for (int index = 0; index < helperCount; index++)
+	{
+		Search* helper = _helpers[index].get();
+		Position* helperBoard = &helperBoards[index];
+		SearchResult* helperResult = &helperResults[index];
+		helperThreads.emplace_back([helper, helperBoard, helperResult]() {
+			*helperResult = helper->iterate(helperBoard);
+		});
+	}
+
+	SearchResult result = iterate(board);
+
+	_stopHelpers = true;
+	for (std::thread& thread : helperThreads)
+	{
+		thread.join();
+	}
+	for (const SearchResult& helperResult : helperResults)
+	{
+		unsigned long long nodes = result.nodes + helperResult.nodes;
+		unsigned long long pawnProbes = result.pawnProbes + helperResult.pawnProbes;
+		unsigned long long pawnHits = result.pawnHits + helperResult.pawnHits;
+		unsigned long long evalProbes = result.evalProbes + helperResult.evalProbes;
+		unsigned long long evalHits = result.evalHits + helperResult.evalHits;
+		if (helperResult.depth > result.depth && helperResult.bestMove != NO_MOVE)
+		{
+			result = helperResult;
+		}
+		result.nodes = nodes;
+		result.pawnProbes = pawnProbes;
+		result.pawnHits = pawnHits;
+		result.evalProbes = evalProbes;
+		result.evalHits = evalHits;
+	}
+
+	// Out of the search the position is no longer bound to the network
+	refreshAccumulator(board, nullptr);
+	result.time = _time.elapsed();
+	return result;
+}
+
+/* Search.iterate():
+   Iterative deepening on one thread, returning the result of the last
+	 completed iteration
+*/
+SearchResult Search::iterate(Position* board)
+{
+	SearchResult result;
+	result.bestMove = NO_MOVE;
+	result.score = 0;
+	result.depth = 0;
+	result.pvLength = 0;
+
+	_isStopped = false;
+	_rootMove = NO_MOVE;
+	_nodes = 0;
+	unsigned long long pawnProbes = _pawnHash.probes();
+	unsigned long long pawnHits = _pawnHash.hits();
+	_evalProbes = 0;
+	_evalHits = 0;
+	clearHeuristics();
+	if (_threadIndex > 0)
+	{
+		perturbHistory();
+	}
+
+	int firstDepth = 1 + _threadIndex % 2;
+	int maxDepth = (_limits.depth > 0 && _limits.depth < MAX_PLY) ? _limits.depth : MAX_PLY - 1;
+	for (_rootDepth = firstDepth; _rootDepth <= maxDepth; _rootDepth++)
+	{
+		int score = negamax(board, _rootDepth, 0, -INFINITE_SCORE, INFINITE_SCORE);
+		if (_isStopped)
+		{
+			break;
+		}
+
+		result.score = score;
+		result.depth = _rootDepth;
+		result.pvLength = _pvLength[0];
+		for (int index = 0; index < result.pvLength; index++)
+		{
+			result.pv[index] = _pvTable[0][index];
+		}
+		result.bestMove = result.pvLength > 0 ? result.pv[0] : NO_MOVE;
+		_rootMove = result.bestMove;
+		if (_observer != nullptr)
+		{
+			result.nodes = _nodes;
+			result.time = _time.elapsed();
+			_observer->iterationCompleted(result);
+		}
+
+		// No legal move, or a mate found: searching deeper changes nothing
+		if (result.bestMove == NO_MOVE || abs(score) >= MATE_SCORE - MAX_PLY)
+		{
+			break;
+		}
+		// The next iteration takes longer than all the previous ones together
+		if (_threadIndex == 0 && _time.softLimitPassed())
+		{
+			break;
+		}
+	}
+
+	result.nodes = _nodes;
+	result.pawnProbes = _pawnHash.probes() - pawnProbes;
+	result.pawnHits = _pawnHash.hits() - pawnHits;
+	result.evalProbes = _evalProbes;
+	result.evalHits = _evalHits;
+	result.time = _time.elapsed();
+	return result;
+}
+
+// After makeMove(): true if the side which just moved left its King in check
+static bool moverKingIsAttacked(const Position* board)
+{
+	int kingSquare = board->findKing(!board->isWhiteTurn);
+	return kingSquare != ChessInfo::NO_SQUARE && board->isAttacked(kingSquare, board->isWhiteTurn);
+}
+
+/* Mate scores count the plies from the root, the table keeps them counted
+	 from the position stored so that they remain right wherever it is found
+*/
+static int scoreToTable(int score, int ply)
+{
+	if (score >= MATE_SCORE - MAX_PLY) return score + ply;
+	if (score <= -(MATE_SCORE - MAX_PLY)) return score - ply;
+	return score;
+}
+
+static int scoreFromTable(int score, int ply)
+{
+	if (score >= MATE_SCORE - MAX_PLY) return score - ply;
+	if (score <= -(MATE_SCORE - MAX_PLY)) return score + ply;
+	return score;
+}
+
+/* Search.negamax():
+   Return the score of the position for the side to move, searched depth
+	 plies deep: within (alpha, beta) the score is exact, a score <= alpha
+	 means the side to move has better elsewhere (fail low), a score >= beta
+	 means the opponent will not allow this position (cut-off)
+*/
+int Search::negamax(Position* board, int depth, int ply, int alpha, int beta)
+{
+	if (depth <= 0)
+	{
+		return quiescence(board, ply, alpha, beta);
+	}
+
+	_pvLength[ply] = 0;
+	_nodes++;
+	if ((_nodes % CHECK_LIMITS_INTERVAL) == 0 || _nodes == _limits.nodes)
+	{
+		checkLimits();
+	}
+	if (_isStopped)
+	{
+		return 0;
+	}
+
+	if (ply >= MAX_PLY - 1)
+	{
+		return evaluateCached(board);
+	}
+
+	// A result stored for this position may do (never at the root, which needs a move)
+	Move tableMove = NO_MOVE;
+	TTEntry entry;
+	if (_table != nullptr && _table->probe(board->key, entry))
+	{
+		tableMove = entry.move;
+		int tableScore = scoreFromTable(entry.score, ply);
+		if (ply > 0 && entry.depth >= depth &&
+			(entry.bound == EXACT_BOUND ||
+			(entry.bound == LOWER_BOUND && tableScore >= beta) ||
+			(entry.bound == UPPER_BOUND && tableScore <= alpha)))
+		{
+			return tableScore;
+		}
+	}
+
+	int legalMoves = 0;
+	int bestScore = -INFINITE_SCORE;
+	Move bestMove = NO_MOVE;
+	int originalAlpha = alpha;
+	bool isWhite = board->isWhiteTurn;
+	Move quietsSearched[MAX_MOVES];
+	int quietCount = 0;
+
+	// The best move of the previous iteration (or found in the table) is searched first
+	Move firstMove = (ply == 0 && _rootMove != NO_MOVE) ? _rootMove : tableMove;
+	MovePicker picker(board, firstMove, _killers[ply], _history[isWhite ? 0 : 1]);
+	Move move;
+	while ((move = picker.next()) != NO_MOVE)
+	{
+		UndoRecord undo;
+		board->makeMove(move, undo);
+		if (moverKingIsAttacked(board))
+		{
+			board->unmakeMove(move, undo);
+			continue;
+		}
+		legalMoves++;
+
+		int score = -negamax(board, depth - 1, ply + 1, -beta, -alpha);
+		board->unmakeMove(move, undo);
+
+		if (_isStopped)
+		{
+			return bestScore;
+		}
+
+		if (score > bestScore)
+		{
+			bestScore = score;
+			if (score > alpha)
+			{
+				alpha = score;
+				bestMove = move;
+
+				// The best line from here is this move then the child's best line
+				_pvTable[ply][0] = move;
+				for (int next = 0; next < _pvLength[ply + 1]; next++)
+				{
+					_pvTable[ply][next + 1] = _pvTable[ply + 1][next];
+				}
+				_pvLength[ply] = _pvLength[ply + 1] + 1;
+
+				if (alpha >= beta)
+				{
+					if (!isCaptureMove(board, move))
+					{
+						storeKiller(ply, move);
+						updateHistory(isWhite, move, depth * depth);
+						for (int index = 0; index < quietCount; index++)
+						{
+							updateHistory(isWhite, quietsSearched[index], -depth * depth);
+						}
+					}
+					break;
+				}
+			}
+		}
+
+		if (!isCaptureMove(board, move))
+		{
+			quietsSearched[quietCount++] = move;
+		}
+	}
+
+	if (legalMoves == 0)
+	{
+		// Checkmate (the sooner the worse) or stalemate
+		bestScore = board->inCheck() ? -(MATE_SCORE - ply) : 0;
+	}
+
+	if (_table != nullptr)
+	{
+		Bound bound = bestScore >= beta ? LOWER_BOUND :
+			(bestScore > originalAlpha ? EXACT_BOUND : UPPER_BOUND);
+		_table->store(board->key, depth, scoreToTable(bestScore, ply), bound, bestMove);
+	}
+	return bestScore;
+}
+
+/* Search.quiescence():
+   Return the score of the position for the side to move once the captures
+	 are played out: the side to move stands pat on the evaluation, or
+	 captures if that does better
+   Delta pruning: a capture that would not bring the score up to alpha
+	 even with the captured piece won for free (plus a margin) is skipped
+*/
+int Search::quiescence(Position* board, int ply, int alpha, int beta)
+{
+	_pvLength[ply] = 0;
+	_nodes++;
+	if ((_nodes % CHECK_LIMITS_INTERVAL) == 0 || _nodes == _limits.nodes)
+	{
+		checkLimits();
+	}
+	if (_isStopped)
+	{
+		return 0;
+	}
+
+	int standPat = evaluateCached(board);
+	if (standPat >= beta || ply >= MAX_PLY - 1)
+	{
+		return standPat;
+	}
+	if (standPat > alpha)
+	{
+		alpha = standPat;
+	}
+
+	int bestScore = standPat;
+	MovePicker picker(board);
+	Move move;
+	while ((move = picker.next()) != NO_MOVE)
+	{
+		if (standPat + captureGain(board, move) + DELTA_MARGIN <= alpha)
+		{
+			// Picked by gain, none of the captures left can do better
+			break;
+		}
+
+		UndoRecord undo;
+		board->makeMove(move, undo);
+		if (moverKingIsAttacked(board))
+		{
+			board->unmakeMove(move, undo);
+			continue;
+		}
+		int score = -quiescence(board, ply + 1, -beta, -alpha);
+		board->unmakeMove(move, undo);
+
+		if (_isStopped)
+		{
+			return bestScore;
+		}
+		if (score > bestScore)
+		{
+			bestScore = score;
+			if (score > alpha)
+			{
+				alpha = score;
+				if (alpha >= beta)
+				{
+					break;
+				}
+			}
+		}
+	}
+	return bestScore;
+}
+
+/* Search.checkLimits():
+   Stop the search once its stop signal is set or, past the first
+	 iteration, once it has used up its nodes or its time; a helper thread
+	 stops when the main thread sets the helpers' signal
+*/
+void Search::checkLimits()
+{
+	if (_stopSignal != nullptr && _stopSignal->load(std::memory_order_relaxed))
+	{
+		_isStopped = true;
+	}
+	else if (_threadIndex == 0 && _rootDepth > 1)
+	{
+		// Helpers leave the limits to the main thread
+		if ((_limits.nodes > 0 && _nodes >= _limits.nodes) || _time.hardLimitPassed())
+		{
+			_isStopped = true;
+		}
+	}
+}
+
+/* Search.evaluateCached():
+   The evaluation of the position, from the cache when it is there; only a
+	 network is worth caching, the material, piece-square and Pawn terms
+	 (kept up to date as the pieces move) cost less than a probe missing
+*/
+int Search::evaluateCached(const Position* board)
+{
+	if (_network == nullptr)
+	{
+		return evaluate(board, &_pawnHash);
+	}
+
+	int score;
+	_evalProbes++;
+	if (_evalCache->probe(board->key, score))
+	{
+		_evalHits++;
+		return score;
+	}
+	score = evaluate(board, &_pawnHash);
+	_evalCache->store(board->key, score);
+	return score;
+}
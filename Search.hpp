@@ -0,0 +1,163 @@
+/* Copyright (C) 2024-2026 Stefan-Mihai MOGA
+This file is part of ChessCtrl application developed by Stefan-Mihai MOGA.
+Fully featured Chess Control written in C++ with the help of the MFC library.
+
+ChessCtrl is free software: you can redistribute it and/or modify it
+under the terms of the GNU General Public License as published by the Open
+Source Initiative, either version 3 of the License, or any later version.
+
+ChessCtrl is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+ChessCtrl. If not, see <http://www.opensource.org/licenses/gpl-3.0.html>*/
+
+// Search.hpp - Search
+/* Negamax search with alpha-beta pruning for the side to move:
+	 every score is seen from the side to move at that node, a child's score
+	 is the negation of the score its opponent gets, and branches that can
+	 no longer change the result at the root are cut off
+   think() deepens iteratively, searching depth 1, 2, 3... until one of
+	 the SearchLimits is reached, and returns the result of the last
+	 completed iteration: the best move, its score and the principal
+	 variation (the line both sides are expected to play), collected in a
+	 triangular table where row ply holds the best line from that ply on
+   An iteration cut short by a limit is thrown away; each iteration starts
+	 with the best move of the previous one, which makes the cut-offs come
+	 sooner
+   At depth 0 the search goes on with the captures only (quiescence search)
+	 until the position is quiet, so that a leaf is never scored in the
+	 middle of an exchange; the side to move may also stand pat, i.e. take
+	 the evaluation as it is instead of capturing
+   Moves are searched in the order of a MovePicker, fed by the killer moves
+	 and the history table kept by the search
+   With a TranspositionTable, a position already searched deep enough is
+	 scored from the table without searching it again, and otherwise the
+	 move found best there is searched first; the table outlives the search
+	 so the next move benefits from it too
+   With more than one thread (Lazy SMP), helper threads run the same
+	 iterative deepening on their own copy of the position, sharing only the
+	 transposition table: what one thread stores cuts the others' searches
+	 short; every other helper starts one ply deeper and each helper orders
+	 its quiet moves with a slightly different history, so that the threads
+	 spread over different parts of the tree; the main thread checks the
+	 limits, stops the helpers when it is done and reports the deepest
+	 completed iteration of all the threads
+   Leaves are scored by evaluate() (Evaluate.hpp), in centipawns, the
+	 units of Piece::Score(), each thread with a PawnHash of its own, whose
+	 probes and hits are reported with the result; being checkmated in n plies
+	 scores -(MATE_SCORE - n), so quicker mates are preferred
+   think() holds the neural network in use when it starts (if any) until
+	 the next search, the threads' positions being bound to it, so that
+	 loading another one meanwhile leaves the search unaffected
+   While a neural network is in use, the scores evaluate() returns are kept
+	 in an EvalCache shared by the threads, so that a position evaluated
+	 once is not evaluated again
+   A Search kept from one move to the next (as UciEngine and ChessBoard
+	 keep theirs) keeps its helper threads' Search objects too, and with
+	 them the Pawn hash tables and the EvalCache, which is only emptied
+	 when the search takes another network than the last one
+*/
+
+#ifndef SEARCH_H
+#define SEARCH_H
+
+#include "EvalCache.hpp"
+#include "Evaluate.hpp"
+#include "MovePicker.hpp"
+#include "Nnue.hpp"
+#include "TimeManager.hpp"
+#include "TranspositionTable.hpp"
+#include <atomic>
+#include <memory>
+#include <vector>
+
+static const int MAX_PLY = 64;
+static const int INFINITE_SCORE = 32000;
+static const int MATE_SCORE = 31000;
+static const int MAX_HISTORY = 16384;
+
+// Nodes between two looks at the stop signal and the limits
+static const unsigned long long CHECK_LIMITS_INTERVAL = 1024;
+
+struct SearchResult {
+	Move bestMove;
+	int score;
+	int depth;
+	unsigned long long nodes;
+	int time;
+	unsigned long long pawnProbes;
+	unsigned long long pawnHits;
+	unsigned long long evalProbes;
+	unsigned long long evalHits;
+	int pvLength;
+	Move pv[MAX_PLY];
+};
+
+/* SearchObserver:
+   Told of each iteration the main thread completes (on that thread): the
+	 result so far, its nodes being those of the main thread alone
+*/
+class SearchObserver {
+
+public:
+	virtual ~SearchObserver() {}
+	virtual void iterationCompleted(const SearchResult& result) = 0;
+};
+
+class Search {
+
+public:
+	/* table, if given, is shared with the searches to come
+	   stopSignal, if given, is the stop token of the search: any thread may
+		 set it to true, and within CHECK_LIMITS_INTERVAL nodes the search
+		 unwinds and returns what it has found so far
+	*/
+	Search(TranspositionTable* table = nullptr, const std::atomic<bool>* stopSignal = nullptr);
+
+	// Search the position within the given limits, board is restored
+	SearchResult think(Position* board, const SearchLimits& limits);
+
+	// Threads searching together, the main one included (1 by default)
+	void setThreads(int threads);
+
+	// Whom to tell of each completed iteration, nullptr (the default) for nobody
+	void setObserver(SearchObserver* observer);
+
+private:
+	SearchResult iterate(Position* board);
+	int negamax(Position* board, int depth, int ply, int alpha, int beta);
+	int quiescence(Position* board, int ply, int alpha, int beta);
+	void clearHeuristics();
+	void perturbHistory();
+	void updateHistory(bool isWhite, Move move, int bonus);
+	void storeKiller(int ply, Move move);
+	void checkLimits();
+	int evaluateCached(const Position* board);
+
+	TranspositionTable* _table;
+	int _threads;
+	int _threadIndex;
+	std::vector<std::unique_ptr<Search>> _helpers;
+	std::atomic<bool> _stopHelpers;
+	const std::atomic<bool>* _stopSignal;
+	SearchObserver* _observer;
+	SearchLimits _limits;
+	TimeManager _time;
+	bool _isStopped;
+	int _rootDepth;
+	Move _rootMove;
+	unsigned long long _nodes;
+	PawnHash _pawnHash;
+	std::shared_ptr<const Network> _network;
+	std::shared_ptr<EvalCache> _evalCache;
+	unsigned long long _evalProbes;
+	unsigned long long _evalHits;
+	Move _killers[MAX_PLY][NUM_KILLERS];
+	int _history[2][ChessInfo::NUM_SQUARES][ChessInfo::NUM_SQUARES];
+	Move _pvTable[MAX_PLY][MAX_PLY];
+	int _pvLength[MAX_PLY];
+};
+
+#endif
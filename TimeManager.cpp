@@ -0,0 +1,58 @@
+/* Copyright (C) 2024-2026 Stefan-Mihai MOGA
+This file is part of ChessCtrl application developed by Stefan-Mihai MOGA.
+Fully featured Chess Control written in C++ with the help of the MFC library.
+
+ChessCtrl is free software: you can redistribute it and/or modify it
+under the terms of the GNU General Public License as published by the Open
+Source Initiative, either version 3 of the License, or any later version.
+
+ChessCtrl is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+ChessCtrl. If not, see <http://www.opensource.org/licenses/gpl-3.0.html>*/
+
+// TimeManager.cpp - Implementation of TimeManager (info in TimeManager.hpp)
+
+#include "TimeManager.hpp"
+#include <algorithm>
+
+// Moves of a time control looked ahead at most, however long it is
+static const int MAX_MOVES_TO_GO = 50;
+// How far past its share a move may run while an iteration completes
+static const int HARD_LIMIT_FACTOR = 3;
+
+TimeManager::TimeManager()
+{
+	_startTime = std::chrono::steady_clock::now();
+	_softLimit = 0;
+	_hardLimit = 0;
+}
+
+void TimeManager::start(const SearchLimits& limits)
+{
+	_startTime = std::chrono::steady_clock::now();
+	_softLimit = 0;
+	_hardLimit = 0;
+
+	if (limits.moveTime > 0)
+	{
+		_softLimit = std::max(1, limits.moveTime / 2);
+		_hardLimit = limits.moveTime;
+	}
+	else if (limits.time > 0)
+	{
+		int movesToGo = limits.movesToGo > 0 ? std::min(limits.movesToGo, MAX_MOVES_TO_GO) : DEFAULT_MOVES_TO_GO;
+		int available = std::max(1, limits.time - MOVE_OVERHEAD);
+		int share = std::min(available, limits.time / movesToGo + limits.increment * 3 / 4);
+		_softLimit = std::max(1, share / 2);
+		_hardLimit = std::max(1, std::min(available, share * HARD_LIMIT_FACTOR));
+	}
+}
+
+int TimeManager::elapsed() const
+{
+	return (int)std::chrono::duration_cast<std::chrono::milliseconds>(
+		std::chrono::steady_clock::now() - _startTime).count();
+}
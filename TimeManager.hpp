@@ -0,0 +1,84 @@
+/* Copyright (C) 2024-2026 Stefan-Mihai MOGA
+This file is part of ChessCtrl application developed by Stefan-Mihai MOGA.
+Fully featured Chess Control written in C++ with the help of the MFC library.
+
+ChessCtrl is free software: you can redistribute it and/or modify it
+under the terms of the GNU General Public License as published by the Open
+Source Initiative, either version 3 of the License, or any later version.
+
+ChessCtrl is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+ChessCtrl. If not, see <http://www.opensource.org/licenses/gpl-3.0.html>*/
+
+// TimeManager.hpp - Time manager
+/* Turns the time limits of a search into two deadlines, in milliseconds
+	 from the start of the search:
+   - the soft deadline: past it no new iteration is started, as the next
+	 one would take about as long as all the previous ones together and
+	 could hardly complete
+   - the hard deadline: the search is cut short on the spot, throwing the
+	 iteration in progress away
+   A fixed move time is spent in full: the soft deadline is half of it and
+	 the hard one all of it. On a clock, a move is given an even share of
+	 the remaining time (the moves to go until the next time control, or
+	 DEFAULT_MOVES_TO_GO if there is none) plus most of the increment; it
+	 may overrun that share when an iteration is under way, up to the hard
+	 deadline, but always leaves MOVE_OVERHEAD on the clock
+*/
+
+#ifndef TIMEMANAGER_H
+#define TIMEMANAGER_H
+
+#include <chrono>
+
+/* Limits of a search, 0 meaning no limit on that dimension:
+   depth - the deepest iteration searched, in plies (at most MAX_PLY - 1)
+   nodes - the nodes searched, all iterations together (by the main thread)
+   moveTime - the wall-clock time of the search, in milliseconds
+   time, increment, movesToGo - the clock of the side to move: the time it
+	 has left and gains after each move, in milliseconds, and the moves to
+	 play until the next time control (ignored if moveTime is given)
+   The first iteration is always completed, so there always is a move
+*/
+struct SearchLimits {
+	int depth = 0;
+	unsigned long long nodes = 0;
+	int moveTime = 0;
+	int time = 0;
+	int increment = 0;
+	int movesToGo = 0;
+};
+
+// Moves the remaining time is shared out between without a time control
+static const int DEFAULT_MOVES_TO_GO = 30;
+// Time kept on the clock for the move to reach the opponent, in milliseconds
+static const int MOVE_OVERHEAD = 50;
+
+class TimeManager {
+
+public:
+	TimeManager();
+
+	// Set the deadlines for the limits, the search starting now
+	void start(const SearchLimits& limits);
+
+	// Milliseconds since start()
+	int elapsed() const;
+
+	// The deadlines, 0 if there is none
+	int softLimit() const { return _softLimit; }
+	int hardLimit() const { return _hardLimit; }
+
+	bool softLimitPassed() const { return _softLimit > 0 && elapsed() >= _softLimit; }
+	bool hardLimitPassed() const { return _hardLimit > 0 && elapsed() >= _hardLimit; }
+
+private:
+	std::chrono::steady_clock::time_point _startTime;
+	int _softLimit;
+	int _hardLimit;
+};
+
+#endif
@@ -0,0 +1,150 @@
+/* Copyright (C) 2024-2026 Stefan-Mihai MOGA
+This file is part of ChessCtrl application developed by Stefan-Mihai MOGA.
+Fully featured Chess Control written in C++ with the help of the MFC library.
+
+ChessCtrl is free software: you can redistribute it and/or modify it
+under the terms of the GNU General Public License as published by the Open
+Source Initiative, either version 3 of the License, or any later version.
+
+ChessCtrl is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+ChessCtrl. If not, see <http://www.opensource.org/licenses/gpl-3.0.html>*/
+
+// TranspositionTable.cpp - Implementation of TranspositionTable (info in TranspositionTable.hpp)
+
+#include "TranspositionTable.hpp"
+#include <climits>
+
+/* Layout of the data word of a slot:
+   bits 0-15: move, bits 16-31: score, bits 32-39: depth,
+   bits 40-47: bound, bits 48-55: generation
+*/
+static unsigned long long packEntry(const TTEntry& entry)
+{
+	return (unsigned long long)entry.move |
+		((unsigned long long)(unsigned short)entry.score << 16) |
+		((unsigned long long)(unsigned char)entry.depth << 32) |
+		((unsigned long long)entry.bound << 40) |
+		((unsigned long long)entry.generation << 48);
+}
+
+static TTEntry unpackEntry(Key key, unsigned long long data)
+{
+	TTEntry entry;
+	entry.key = key;
+	entry.move = (Move)(data & 0xFFFF);
+	entry.score = (short)(unsigned short)((data >> 16) & 0xFFFF);
+	entry.depth = (signed char)(unsigned char)((data >> 32) & 0xFF);
+	entry.bound = (unsigned char)((data >> 40) & 0xFF);
+	entry.generation = (unsigned char)((data >> 48) & 0xFF);
+	return entry;
+}
+
+TranspositionTable::TranspositionTable(int megabytes)
+{
+	_bucketCount = 0;
+	_mask = 0;
+	_generation = 0;
+	resize(megabytes);
+}
+
+void TranspositionTable::resize(int megabytes)
+{
+	size_t bucketCount = 1;
+	size_t maxBuckets = ((size_t)(megabytes > 0 ? megabytes : 0) << 20) / sizeof(Bucket);
+	while (bucketCount * 2 <= maxBuckets)
+	{
+		bucketCount *= 2;
+	}
+
+	_buckets.reset();
+	_buckets.reset(new Bucket[bucketCount]);
+	_bucketCount = bucketCount;
+	_mask = bucketCount - 1;
+	clear();
+}
+
+void TranspositionTable::clear()
+{
+	for (size_t index = 0; index < _bucketCount; index++)
+	{
+		for (Slot& slot : _buckets[index].slots)
+		{
+			slot.keyXorData.store(0, std::memory_order_relaxed);
+			slot.data.store(0, std::memory_order_relaxed);
+		}
+	}
+	_generation = 0;
+}
+
+void TranspositionTable::newSearch()
+{
+	_generation++;
+}
+
+bool TranspositionTable::probe(Key key, TTEntry& entry) const
+{
+	for (const Slot& slot : bucketOf(key).slots)
+	{
+		unsigned long long data = slot.data.load(std::memory_order_relaxed);
+		unsigned long long keyXorData = slot.keyXorData.load(std::memory_order_relaxed);
+		if ((keyXorData ^ data) == key)
+		{
+			entry = unpackEntry(key, data);
+			if (entry.bound != NO_BOUND)
+			{
+				return true;
+			}
+		}
+	}
+	return false;
+}
+
+/* TranspositionTable.store():
+   The entry of the same position is overwritten (keeping its move if the
+	 new result has none), otherwise the entry valued the least: an entry
+	 counts for its depth, minus a penalty for each search since it was
+	 stored
+*/
+void TranspositionTable::store(Key key, int depth, int score, Bound bound, Move move)
+{
+	Bucket& bucket = bucketOf(key);
+	Slot* replaced = &bucket.slots[0];
+	TTEntry replacedEntry = unpackEntry(0, 0);
+	int replacedValue = INT_MAX;
+	for (Slot& slot : bucket.slots)
+	{
+		unsigned long long data = slot.data.load(std::memory_order_relaxed);
+		Key slotKey = slot.keyXorData.load(std::memory_order_relaxed) ^ data;
+		TTEntry entry = unpackEntry(slotKey, data);
+		if (slotKey == key || entry.bound == NO_BOUND)
+		{
+			replaced = &slot;
+			replacedEntry = entry;
+			break;
+		}
+		int age = (unsigned char)(_generation - entry.generation);
+		int value = entry.depth - 8 * age;
+		if (value < replacedValue)
+		{
+			replaced = &slot;
+			replacedEntry = entry;
+			replacedValue = value;
+		}
+	}
+
+	TTEntry entry;
+	entry.key = key;
+	entry.move = (move == NO_MOVE && replacedEntry.key == key) ? replacedEntry.move : move;
+	entry.score = (short)score;
+	entry.depth = (signed char)depth;
+	entry.bound = (unsigned char)bound;
+	entry.generation = _generation;
+
+	unsigned long long data = packEntry(entry);
+	replaced->keyXorData.store(key ^ data, std::memory_order_relaxed);
+	replaced->data.store(data, std::memory_order_relaxed);
+}
@@ -0,0 +1,96 @@
+/* Copyright (C) 2024-2026 Stefan-Mihai MOGA
+This file is part of ChessCtrl application developed by Stefan-Mihai MOGA.
+Fully featured Chess Control written in C++ with the help of the MFC library.
+
+ChessCtrl is free software: you can redistribute it and/or modify it
+under the terms of the GNU General Public License as published by the Open
+Source Initiative, either version 3 of the License, or any later version.
+
+ChessCtrl is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+ChessCtrl. If not, see <http://www.opensource.org/licenses/gpl-3.0.html>*/
+
+// TranspositionTable.hpp - Transposition table
+/* Remembers what the search found about the positions it went through,
+	 so that a position reached again by another move order (a
+	 transposition) or by the next iteration is not searched all over again
+   Each entry keeps the full key of its position, the best move found, the
+	 score with the kind of bound it is (exact, at least or at most) and the
+	 depth it was searched to; entries come in buckets of four filling one
+	 64-byte cache line, so a probe reads a single line of memory
+   A position can only be stored in the bucket its key selects; when the
+	 bucket is full the entry replaced is the least useful one: left over
+	 from an older search, or else searched the least deep
+   The table is shared by the search threads without any lock: a slot holds
+	 two 64-bit words, the packed data and the key xored with the data, each
+	 read and written atomically; a slot half overwritten by another thread
+	 no longer xors back to its key and is taken for another position
+*/
+
+#ifndef TRANSPOSITIONTABLE_H
+#define TRANSPOSITIONTABLE_H
+
+#include <atomic>
+#include <memory>
+
+#include "Move.hpp"
+#include "Zobrist.hpp"
+
+enum Bound { NO_BOUND = 0, UPPER_BOUND, LOWER_BOUND, EXACT_BOUND };
+
+// An entry as read from (or written to) the table
+struct TTEntry {
+	Key key;
+	Move move;
+	short score;
+	signed char depth;
+	unsigned char bound;
+	unsigned char generation;
+};
+
+static const int TT_BUCKET_SIZE = 4;
+static const int DEFAULT_HASH_MB = 16;
+
+class TranspositionTable {
+
+public:
+	TranspositionTable(int megabytes = DEFAULT_HASH_MB);
+
+	/* Reallocate the table (emptied) with the largest power of two of
+		 buckets fitting in the given size, in MB (one bucket at least)
+	   N.B.: Neither resize() nor clear() may run during a search
+	*/
+	void resize(int megabytes);
+	void clear();
+
+	// To be called by each new search, so that older entries get replaced first
+	void newSearch();
+
+	// Copy the entry of the position into entry, false if there is none
+	bool probe(Key key, TTEntry& entry) const;
+	void store(Key key, int depth, int score, Bound bound, Move move);
+
+private:
+	struct Slot {
+		std::atomic<unsigned long long> keyXorData;
+		std::atomic<unsigned long long> data;
+	};
+
+	struct alignas(64) Bucket {
+		Slot slots[TT_BUCKET_SIZE];
+	};
+	static_assert(sizeof(Bucket) == 64, "a bucket should fill one cache line");
+
+	Bucket& bucketOf(Key key) { return _buckets[key & _mask]; }
+	const Bucket& bucketOf(Key key) const { return _buckets[key & _mask]; }
+
+	std::unique_ptr<Bucket[]> _buckets;
+	size_t _bucketCount;
+	Key _mask;
+	unsigned char _generation;
+};
+
+#endif
@@ -0,0 +1,499 @@
+/* Copyright (C) 2024-2026 Stefan-Mihai MOGA
+This file is part of ChessCtrl application developed by Stefan-Mihai MOGA.
+Fully featured Chess Control written in C++ with the help of the MFC library.
+
+ChessCtrl is free software: you can redistribute it and/or modify it
+under the terms of the GNU General Public License as published by the Open
+Source Initiative, either version 3 of the License, or any later version.
+
+ChessCtrl is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+ChessCtrl. If not, see <http://www.opensource.org/licenses/gpl-3.0.html>*/
+
+/* UciEngine.cpp - Headless UCI engine, utilising the Search library
+   Speaks the Universal Chess Interface on stdin/stdout, so that GUIs,
+	 tournament managers and analysis scripts can drive the engine:
+   - uci, isready, ucinewgame, quit
+   - position startpos|fen <FEN> [moves <move>...]
+   - go [wtime <ms>] [btime <ms>] [winc <ms>] [binc <ms>] [movestogo <n>]
+	 [movetime <ms>] [depth <plies>] [nodes <n>] [infinite]
+   - stop: the search returns at once, answering with its best move so far
+   - setoption name Hash|Threads value <n>
+   - setoption name EvalFile value <path>: loads the neural network in the
+	 file, which then scores the positions (unless UseNNUE is false)
+   - setoption name UseNNUE value true|false
+   - bench [depth]: see below
+   The search runs on a thread of its own, commands keep being read (and
+	 isready answered) meanwhile; it sends an info line with each completed
+	 iteration and, with helper threads, one with the nodes of all of them
+	 at the end
+   Unknown go parameters (ponder, searchmoves and its moves...) are skipped
+   UciEngine bench [depth] runs the bench and exits: a fixed set of
+	 positions searched to a fixed depth (BENCH_DEPTH by default) on one
+	 thread, each with an emptied table of DEFAULT_HASH_MB, so that the
+	 total of the nodes is the same on every run and every machine; it
+	 changes when the search or the evaluation does, and serves as their
+	 signature, while the nodes per second compare machines and builds
+   After each search, and at the end of the bench, the engine tells how
+	 often the Pawn hash spared it evaluating the Pawn structure, and with a
+	 neural network, how often the evaluation cache spared it running it
+*/
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdlib>
+#include <iostream>
+#include <iterator>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+
+using namespace std;
+
+#include "MoveGen.hpp"
+#include "Search.hpp"
+
+static const int MAX_HASH_MB = 65536;
+static const int MAX_THREADS = 256;
+
+static const int BENCH_DEPTH = 7;
+
+// Openings, middlegames and endgames of all kinds, the perft positions among them
+static const char* const benchPositions[] = {
+	START_FEN,
+	"r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+	"8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1",
+	"r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1",
+	"rnbq1k1r/pp1Pbppp/2p5/8/2B5/8/PPP1NnPP/RNBQK2R w KQ - 1 8",
+	"r4rk1/1pp1qppp/p1np1n2/2b1p1B1/2B1P1b1/P1NP1N2/1PP1QPPP/R4RK1 w - - 0 10",
+	"r1bqkb1r/pppp1ppp/2n2n2/4p3/2B1P3/5N2/PPPP1PPP/RNBQK2R w KQkq - 4 4",
+	"rnbqkb1r/pp3ppp/4pn2/2pp4/3P1B2/4PN2/PPP2PPP/RN1QKB1R w KQkq - 0 5",
+	"r2q1rk1/pp2bppp/2n1pn2/3p4/2PP4/2N1PN2/PP3PPP/R1BQ1RK1 w - - 1 10",
+	"2r3k1/pp3ppp/4p3/3pP3/3P4/P4N2/1P3PPP/2R3K1 w - - 0 25",
+	"6k1/5p2/6p1/8/7p/8/6PP/6K1 b - - 0 40",
+	"8/8/4k3/3p4/3P4/4K3/8/8 w - - 0 50",
+	"8/k7/3p4/p2P1p2/P2P1P2/8/8/K7 w - - 0 1",
+	"8/8/8/5k2/8/3K4/4R3/8 w - - 0 60",
+	"4k3/8/8/8/8/8/4P3/4K3 w - - 0 1",
+	"r1b1k2r/ppppnppp/2n2q2/2b5/3NP3/2P1B3/PP3PPP/RN1QKB1R w KQkq - 0 7",
+};
+static const int BENCH_SIZE = sizeof(benchPositions) / sizeof(benchPositions[0]);
+
+// Hits of a cache, in percents of its probes
+static int hitRate(unsigned long long probes, unsigned long long hits)
+{
+	return probes > 0 ? (int)(hits * 100 / probes) : 0;
+}
+
+/* The depth given to bench, BENCH_DEPTH if there is none or it is not a
+	 positive number (depth 0 would be no limit at all)
+*/
+static int benchDepth(const string& text)
+{
+	int depth = atoi(text.c_str());
+	return depth >= 1 ? depth : BENCH_DEPTH;
+}
+
+// Returns the total of the nodes, the signature
+static unsigned long long runBench(int depth)
+{
+	TranspositionTable table(DEFAULT_HASH_MB);
+	SearchLimits limits;
+	limits.depth = depth;
+	unsigned long long nodes = 0;
+	unsigned long long pawnProbes = 0;
+	unsigned long long pawnHits = 0;
+	unsigned long long evalProbes = 0;
+	unsigned long long evalHits = 0;
+	auto start = chrono::steady_clock::now();
+	for (int index = 0; index < BENCH_SIZE; index++)
+	{
+		Position board;
+		board.loadFEN(benchPositions[index]);
+		table.clear();
+		Search search(&table);
+		SearchResult result = search.think(&board, limits);
+		nodes += result.nodes;
+		pawnProbes += result.pawnProbes;
+		pawnHits += result.pawnHits;
+		evalProbes += result.evalProbes;
+		evalHits += result.evalHits;
+		cout << "Position " << (index + 1) << "/" << BENCH_SIZE << ": " << benchPositions[index]
+			<< "  nodes " << result.nodes << "  bestmove " << moveToString(result.bestMove) << endl;
+	}
+
+	long long time = chrono::duration_cast<chrono::milliseconds>(chrono::steady_clock::now() - start).count();
+	cout << "Depth: " << depth << endl;
+	cout << "Time: " << time << " ms" << endl;
+	cout << "Nodes: " << nodes << endl;
+	cout << "NPS: " << (time > 0 ? nodes * 1000 / time : nodes) << endl;
+	if (pawnProbes > 0)
+	{
+		cout << "Pawn hash hits: " << hitRate(pawnProbes, pawnHits) << "%" << endl;
+	}
+	if (evalProbes > 0)
+	{
+		cout << "Eval cache hits: " << hitRate(evalProbes, evalHits) << "%" << endl;
+	}
+	return nodes;
+}
+
+class UciEngine : public SearchObserver {
+
+public:
+	UciEngine();
+	~UciEngine();
+
+	// Reads and answers the commands until quit (or the end of the input)
+	void run();
+
+	// The info line of each completed iteration, on the search thread
+	void iterationCompleted(const SearchResult& result) override;
+
+private:
+	void send(const string& text);
+	void sendInfo(const SearchResult& result);
+	void setPosition(istringstream& input);
+	void setOption(istringstream& input);
+	void go(istringstream& input);
+	void stop();
+	void searchPosition(Position board, SearchLimits limits);
+	string scoreToString(int score) const;
+
+	Position _board;
+	TranspositionTable _table;
+	int _threads;
+	bool _useNetwork;
+	thread _searchThread;
+
+	/* The stop token of the search; an infinite search holds its answer
+		 back until stop sets it
+	*/
+	atomic<bool> _stopSignal;
+
+	// Kept from one go to the next, caches and helper threads' tables included
+	Search _search;
+	bool _isInfinite;
+	mutex _lock;
+	condition_variable _stopped;
+	mutex _outputLock;
+};
+
+UciEngine::UciEngine() : _table(DEFAULT_HASH_MB), _search(&_table, &_stopSignal)
+{
+	_board.loadFEN(START_FEN);
+	_threads = 1;
+	_useNetwork = true;
+	_stopSignal = false;
+	_isInfinite = false;
+	_search.setObserver(this);
+}
+
+UciEngine::~UciEngine()
+{
+	stop();
+}
+
+// Lines of the two threads never interleave
+void UciEngine::send(const string& text)
+{
+	lock_guard<mutex> guard(_outputLock);
+	cout << text << endl;
+}
+
+void UciEngine::run()
+{
+	string line;
+	while (getline(cin, line))
+	{
+		istringstream input(line);
+		string command;
+		input >> command;
+		if (command == "uci")
+		{
+			send("id name ChessCtrl");
+			send("id author Stefan-Mihai MOGA");
+			send("option name Hash type spin default " + to_string(DEFAULT_HASH_MB) +
+				" min 1 max " + to_string(MAX_HASH_MB));
+			send("option name Threads type spin default 1 min 1 max " + to_string(MAX_THREADS));
+			send("option name EvalFile type string default <empty>");
+			send("option name UseNNUE type check default true");
+			send("uciok");
+		}
+		else if (command == "isready")
+		{
+			send("readyok");
+		}
+		else if (command == "ucinewgame")
+		{
+			stop();
+			_table.clear();
+		}
+		else if (command == "position")
+		{
+			stop();
+			setPosition(input);
+		}
+		else if (command == "setoption")
+		{
+			stop();
+			setOption(input);
+		}
+		else if (command == "go")
+		{
+			stop();
+			go(input);
+		}
+		else if (command == "stop")
+		{
+			stop();
+		}
+		else if (command == "bench")
+		{
+			stop();
+			string depth;
+			input >> depth;
+			runBench(benchDepth(depth));
+		}
+		else if (command == "quit")
+		{
+			break;
+		}
+	}
+}
+
+/* UciEngine.setPosition():
+   The position from its FEN (or the start position), then the moves played
+	 from it; the first move which is not legal and whatever follows it are
+	 ignored
+*/
+void UciEngine::setPosition(istringstream& input)
+{
+	string token;
+	input >> token;
+	string fen;
+	if (token == "startpos")
+	{
+		fen = START_FEN;
+		input >> token;
+	}
+	else if (token == "fen")
+	{
+		while (input >> token && token != "moves")
+		{
+			fen += (fen.empty() ? "" : " ") + token;
+		}
+	}
+
+	Position board;
+	if (!board.loadFEN(fen.c_str()))
+	{
+		send("info string invalid position: " + fen);
+		return;
+	}
+	if (token == "moves")
+	{
+		while (input >> token)
+		{
+			Move move = parseMove(&board, token.c_str());
+			if (move == NO_MOVE)
+			{
+				send("info string illegal move: " + token);
+				break;
+			}
+			UndoRecord undo;
+			board.makeMove(move, undo);
+		}
+	}
+	_board = board;
+}
+
+void UciEngine::setOption(istringstream& input)
+{
+	string token, name, value;
+	input >> token;
+	while (input >> token && token != "value")
+	{
+		name += (name.empty() ? "" : " ") + token;
+	}
+	getline(input >> ws, value);
+
+	int number = atoi(value.c_str());
+	if (name == "Hash")
+	{
+		_table.resize(clamp(number, 1, MAX_HASH_MB));
+	}
+	else if (name == "Threads")
+	{
+		_threads = clamp(number, 1, MAX_THREADS);
+	}
+	else if (name == "EvalFile")
+	{
+		if (value.empty() || value == "<empty>")
+		{
+			return;
+		}
+		if (loadNetwork(value.c_str()))
+		{
+			useNetwork(_useNetwork);
+			_table.clear();
+			send("info string network " + value + " loaded, " + networkKernels() + " kernels");
+		}
+		else
+		{
+			send("info string could not load network " + value);
+		}
+	}
+	else if (name == "UseNNUE")
+	{
+		// The scores in the table come from the evaluation used before
+		_useNetwork = value == "true";
+		useNetwork(_useNetwork);
+		_table.clear();
+	}
+	else
+	{
+		send("info string unknown option: " + name);
+	}
+}
+
+/* UciEngine.go():
+   Turns the go parameters into SearchLimits, with the clock of the side to
+	 move (the TimeManager of the search makes deadlines out of it)
+*/
+void UciEngine::go(istringstream& input)
+{
+	SearchLimits limits;
+	int time[2] = { 0, 0 };
+	int increment[2] = { 0, 0 };
+	int movesToGo = 0;
+	bool isInfinite = false;
+	string token;
+	while (input >> token)
+	{
+		if (token == "infinite")
+		{
+			isInfinite = true;
+			continue;
+		}
+		// Only these take a number; anything else (ponder, searchmoves...) is skipped alone
+		static const char* const numericKeys[] = { "wtime", "btime", "winc", "binc", "movestogo", "movetime", "depth", "nodes" };
+		if (find(begin(numericKeys), end(numericKeys), token) == end(numericKeys))
+		{
+			continue;
+		}
+		string text;
+		input >> text;
+		long long value = atoll(text.c_str());
+		if (token == "wtime") time[0] = (int)value;
+		else if (token == "btime") time[1] = (int)value;
+		else if (token == "winc") increment[0] = (int)value;
+		else if (token == "binc") increment[1] = (int)value;
+		else if (token == "movestogo") movesToGo = (int)value;
+		else if (token == "movetime") limits.moveTime = (int)value;
+		else if (token == "depth") limits.depth = (int)value;
+		else if (token == "nodes") limits.nodes = (unsigned long long)value;
+	}
+
+	int side = _board.isWhiteTurn ? 0 : 1;
+	if (!isInfinite)
+	{
+		limits.time = time[side];
+		limits.increment = increment[side];
+		limits.movesToGo = movesToGo;
+	}
+
+	_stopSignal = false;
+	_isInfinite = isInfinite;
+	_searchThread = thread(&UciEngine::searchPosition, this, _board, limits);
+}
+
+// Stop the search, if there is one, once it has answered
+void UciEngine::stop()
+{
+	{
+		lock_guard<mutex> guard(_lock);
+		_stopSignal = true;
+	}
+	_stopped.notify_all();
+	if (_searchThread.joinable())
+	{
+		_searchThread.join();
+	}
+}
+
+// The search thread: search, then report the result and the best move
+void UciEngine::searchPosition(Position board, SearchLimits limits)
+{
+	_search.setThreads(_threads);
+	SearchResult result = _search.think(&board, limits);
+
+	if (_isInfinite)
+	{
+		unique_lock<mutex> guard(_lock);
+		_stopped.wait(guard, [this]() { return _stopSignal.load(); });
+	}
+
+	// The helpers' nodes, or a deeper iteration of theirs, make a last line
+	if (_threads > 1)
+	{
+		sendInfo(result);
+	}
+	if (result.pawnProbes > 0)
+	{
+		send("info string pawn hash hits " + to_string(hitRate(result.pawnProbes, result.pawnHits)) + "%");
+	}
+	if (result.evalProbes > 0)
+	{
+		send("info string eval cache hits " + to_string(hitRate(result.evalProbes, result.evalHits)) + "%");
+	}
+	send("bestmove " + (result.bestMove != NO_MOVE ? moveToString(result.bestMove) : string("0000")));
+}
+
+void UciEngine::iterationCompleted(const SearchResult& result)
+{
+	sendInfo(result);
+}
+
+void UciEngine::sendInfo(const SearchResult& result)
+{
+	ostringstream info;
+	info << "info depth " << result.depth << " score " << scoreToString(result.score)
+		<< " nodes " << result.nodes << " time " << result.time
+		<< " nps " << (result.time > 0 ? result.nodes * 1000 / result.time : result.nodes) << " pv";
+	for (int index = 0; index < result.pvLength; index++)
+	{
+		info << " " << moveToString(result.pv[index]);
+	}
+	send(info.str());
+}
+
+// Scores in centipawns (a Pawn being worth pieceValue() of a Pawn), or mate in moves
+string UciEngine::scoreToString(int score) const
+{
+	if (abs(score) >= MATE_SCORE - MAX_PLY)
+	{
+		int plies = MATE_SCORE - abs(score);
+		return "mate " + to_string(score > 0 ? (plies + 1) / 2 : -(plies + 1) / 2);
+	}
+	return "cp " + to_string(score * 100 / pieceValue(makePieceCode(PAWN, true)));
+}
+
+int main(int argc, char* argv[])
+{
+	if (argc > 1 && string(argv[1]) == "bench")
+	{
+		runBench(benchDepth(argc > 2 ? argv[2] : ""));
+		return 0;
+	}
+
+	UciEngine engine;
+	engine.run();
+	return 0;
+}
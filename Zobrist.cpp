@@ -0,0 +1,57 @@
+/* Copyright (C) 2024-2026 Stefan-Mihai MOGA
+This file is part of ChessCtrl application developed by Stefan-Mihai MOGA.
+Fully featured Chess Control written in C++ with the help of the MFC library.
+
+ChessCtrl is free software: you can redistribute it and/or modify it
+under the terms of the GNU General Public License as published by the Open
+Source Initiative, either version 3 of the License, or any later version.
+
+ChessCtrl is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+ChessCtrl. If not, see <http://www.opensource.org/licenses/gpl-3.0.html>*/
+
+// Zobrist.cpp - Implementation of the Zobrist keys (info in Zobrist.hpp)
+
+#include "Zobrist.hpp"
+
+Key zobristPieces[16][64];
+Key zobristCastling[16];
+Key zobristEnPassant[8];
+Key zobristBlackToMove;
+
+// xorshift64* generator, a fixed seed keeps the keys the same from run to run
+static Key nextRandom(Key& state)
+{
+	state ^= state >> 12;
+	state ^= state << 25;
+	state ^= state >> 27;
+	return state * 2685821657736338717ULL;
+}
+
+static struct ZobristInitializer {
+	ZobristInitializer()
+	{
+		Key state = 1070372ULL;
+		for (int code = 0; code < 16; code++)
+		{
+			for (int square = 0; square < 64; square++)
+			{
+				zobristPieces[code][square] = nextRandom(state);
+			}
+		}
+		// No castling right at all leaves the key untouched, as for an empty board
+		zobristCastling[0] = 0;
+		for (int rights = 1; rights < 16; rights++)
+		{
+			zobristCastling[rights] = nextRandom(state);
+		}
+		for (int file = 0; file < 8; file++)
+		{
+			zobristEnPassant[file] = nextRandom(state);
+		}
+		zobristBlackToMove = nextRandom(state);
+	}
+} zobristInitializer;
@@ -0,0 +1,36 @@
+/* Copyright (C) 2024-2026 Stefan-Mihai MOGA
+This file is part of ChessCtrl application developed by Stefan-Mihai MOGA.
+Fully featured Chess Control written in C++ with the help of the MFC library.
+
+ChessCtrl is free software: you can redistribute it and/or modify it
+under the terms of the GNU General Public License as published by the Open
+Source Initiative, either version 3 of the License, or any later version.
+
+ChessCtrl is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with
+ChessCtrl. If not, see <http://www.opensource.org/licenses/gpl-3.0.html>*/
+
+// Zobrist.hpp - Zobrist keys
+/* A position is identified by the exclusive or of one random number per
+	 (piece, square) on the board, one per castling rights combination, one
+	 per file of the en passant square and one when Black is to move
+   A move changes only a few of these, so the key of a position is kept up
+	 to date by xoring the numbers in and out as the pieces move instead of
+	 being computed from scratch (see Position)
+*/
+
+#ifndef ZOBRIST_H
+#define ZOBRIST_H
+
+typedef unsigned long long Key;
+
+// Indexed by PieceCode (White 1-6, Black 9-14) and square
+extern Key zobristPieces[16][64];
+extern Key zobristCastling[16];
+extern Key zobristEnPassant[8];
+extern Key zobristBlackToMove;
+
+#endif